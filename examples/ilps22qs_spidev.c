@@ -0,0 +1,220 @@
+/**
+  ******************************************************************************
+  * @file    ilps22qs_spidev.c
+  * @author  Sensors Software Solution Team
+  * @brief   Linux spidev platform backend for the ILPS22QS driver
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/*
+ * Usage:
+ *
+ *   ilps22qs_spidev_t spi;
+ *   stmdev_ctx_t dev_ctx;
+ *
+ *   ilps22qs_spidev_open(&spi, "/dev/spidev0.0", 10000000U);
+ *   dev_ctx.write_reg = ilps22qs_spidev_write;
+ *   dev_ctx.read_reg = ilps22qs_spidev_read;
+ *   dev_ctx.handle = &spi;
+ *
+ * Every driver call is one chip-select assertion: the address byte (MSb set
+ * for a read) followed by the data. Multi-byte access relies on IF_ADD_INC,
+ * enabled by ilps22qs_init_set(&dev_ctx, ILPS22QS_DRV_RDY).
+ * ilps22qs_spidev_batch() chains several transactions in one ioctl, with
+ * cs_change releasing chip select between them.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "ilps22qs_spidev.h"
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/spi/spidev.h>
+
+/**
+  * @defgroup    Spidev_Private_functions
+  * @{
+  *
+  */
+
+static int ilps22qs_spidev_sys_ioctl(int fd, unsigned long req, void *arg)
+{
+  return ioctl(fd, req, arg);
+}
+
+static int32_t ilps22qs_spidev_xfer(ilps22qs_spidev_t *dev,
+                                    struct spi_ioc_transfer *tr, uint32_t n)
+{
+  dev->syscalls++;
+
+  return (dev->ioctl(dev->fd, SPI_IOC_MESSAGE(n), tr) < 0) ? -1 : 0;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @brief  Open a spidev node: SPI mode 3, 8 bit words.
+  *
+  * @param  dev       spidev handler.(ptr)
+  * @param  path      device node, i.e. "/dev/spidev0.0"
+  * @param  speed_hz  SCK frequency
+  * @retval           0 -> no Error, -1 -> open or configuration failed
+  *
+  */
+int32_t ilps22qs_spidev_open(ilps22qs_spidev_t *dev, const char *path,
+                             uint32_t speed_hz)
+{
+  uint8_t mode = SPI_MODE_3;
+  uint8_t bits = 8U;
+
+  (void)memset(dev, 0, sizeof(ilps22qs_spidev_t));
+  dev->ioctl = ilps22qs_spidev_sys_ioctl;
+  dev->speed_hz = speed_hz;
+
+  dev->fd = open(path, O_RDWR);
+  if (dev->fd < 0)
+  {
+    return -1;
+  }
+
+  if ((ioctl(dev->fd, SPI_IOC_WR_MODE, &mode) < 0) ||
+      (ioctl(dev->fd, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0) ||
+      (ioctl(dev->fd, SPI_IOC_WR_MAX_SPEED_HZ, &speed_hz) < 0))
+  {
+    (void)close(dev->fd);
+    dev->fd = -1;
+    return -1;
+  }
+
+  return 0;
+}
+
+/**
+  * @brief  Close the spidev node.
+  *
+  * @param  dev   spidev handler.(ptr)
+  *
+  */
+void ilps22qs_spidev_close(ilps22qs_spidev_t *dev)
+{
+  if (dev->fd >= 0)
+  {
+    (void)close(dev->fd);
+    dev->fd = -1;
+  }
+}
+
+/**
+  * @brief  Send several register transactions with one ioctl. Each one is
+  *         an address transfer followed by a data transfer; chip select is
+  *         released after each transaction (cs_change) and at the end.
+  *
+  * @param  handle  spidev handler (ilps22qs_spidev_t).(ptr)
+  * @param  txn     transactions.(ptr)
+  * @param  num     number of transactions, 1 .. ILPS22QS_SPIDEV_TXN_MAX
+  * @retval         0 -> no Error, -1 -> invalid parameters or ioctl failed
+  *
+  */
+int32_t ilps22qs_spidev_batch(void *handle, const ilps22qs_spidev_txn_t *txn,
+                              uint8_t num)
+{
+  ilps22qs_spidev_t *dev = (ilps22qs_spidev_t *)handle;
+  struct spi_ioc_transfer tr[2U * ILPS22QS_SPIDEV_TXN_MAX];
+  uint8_t addr[ILPS22QS_SPIDEV_TXN_MAX];
+  uint8_t i;
+
+  if ((dev == NULL) || (txn == NULL) || (num == 0U) ||
+      (num > ILPS22QS_SPIDEV_TXN_MAX))
+  {
+    return -1;
+  }
+
+  (void)memset(tr, 0, sizeof(tr));
+  for (i = 0U; i < num; i++)
+  {
+    addr[i] = (txn[i].write != 0U) ? (txn[i].reg & ILPS22QS_SPI_ADD_MASK) :
+              (txn[i].reg | ILPS22QS_SPI_READ_BIT);
+
+    tr[2U * i].tx_buf = (unsigned long)&addr[i];
+    tr[2U * i].len = 1U;
+    tr[2U * i].speed_hz = dev->speed_hz;
+    tr[2U * i].bits_per_word = 8U;
+
+    if (txn[i].write != 0U)
+    {
+      tr[(2U * i) + 1U].tx_buf = (unsigned long)txn[i].data;
+    }
+    else
+    {
+      tr[(2U * i) + 1U].rx_buf = (unsigned long)txn[i].data;
+    }
+    tr[(2U * i) + 1U].len = txn[i].len;
+    tr[(2U * i) + 1U].speed_hz = dev->speed_hz;
+    tr[(2U * i) + 1U].bits_per_word = 8U;
+    /* release chip select before the next transaction */
+    tr[(2U * i) + 1U].cs_change = ((i + 1U) < num) ? 1U : 0U;
+  }
+
+  return ilps22qs_spidev_xfer(dev, tr, 2U * (uint32_t)num);
+}
+
+/**
+  * @brief  stmdev_write_ptr on spidev.
+  *
+  * @param  handle  spidev handler (ilps22qs_spidev_t).(ptr)
+  * @param  reg     first register address
+  * @param  buf     data to write.(ptr)
+  * @param  len     number of bytes
+  * @retval         0 -> no Error, -1 -> ioctl failed
+  *
+  */
+int32_t ilps22qs_spidev_write(void *handle, uint8_t reg, const uint8_t *buf,
+                              uint16_t len)
+{
+  ilps22qs_spidev_txn_t txn;
+
+  txn.reg = reg;
+  txn.write = 1U;
+  txn.data = (uint8_t *)buf;
+  txn.len = len;
+
+  return ilps22qs_spidev_batch(handle, &txn, 1U);
+}
+
+/**
+  * @brief  stmdev_read_ptr on spidev.
+  *
+  * @param  handle  spidev handler (ilps22qs_spidev_t).(ptr)
+  * @param  reg     first register address
+  * @param  buf     data read.(ptr)
+  * @param  len     number of bytes
+  * @retval         0 -> no Error, -1 -> ioctl failed
+  *
+  */
+int32_t ilps22qs_spidev_read(void *handle, uint8_t reg, uint8_t *buf,
+                             uint16_t len)
+{
+  ilps22qs_spidev_txn_t txn;
+
+  txn.reg = reg;
+  txn.write = 0U;
+  txn.data = buf;
+  txn.len = len;
+
+  return ilps22qs_spidev_batch(handle, &txn, 1U);
+}
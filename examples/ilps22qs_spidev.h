@@ -0,0 +1,80 @@
+/**
+  ******************************************************************************
+  * @file    ilps22qs_spidev.h
+  * @author  Sensors Software Solution Team
+  * @brief   Linux spidev platform backend for the ILPS22QS driver
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ILPS22QS_SPIDEV_H
+#define ILPS22QS_SPIDEV_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "ilps22qs_reg.h"
+
+/** @defgroup  ILPS22QS_Spidev
+  * @brief     stmdev_ctx_t read / write functions on /dev/spidevX.Y and a
+  *            batch entry point sending several register transactions in
+  *            a single SPI_IOC_MESSAGE(n) ioctl.
+  * @{
+  *
+  */
+
+#ifndef ILPS22QS_SPIDEV_TXN_MAX
+#define ILPS22QS_SPIDEV_TXN_MAX          16U /* transactions per batch */
+#endif /* ILPS22QS_SPIDEV_TXN_MAX */
+
+typedef int (*ilps22qs_spidev_ioctl_ptr)(int fd, unsigned long req, void *arg);
+
+typedef struct
+{
+  int fd;
+  uint32_t speed_hz;
+  /* ioctl() by default, a loopback can be installed for host tests */
+  ilps22qs_spidev_ioctl_ptr ioctl;
+  uint32_t syscalls;               /* ioctl calls issued */
+} ilps22qs_spidev_t;
+
+typedef struct
+{
+  uint8_t reg;
+  uint8_t write;                   /* 1: write data, 0: read into data */
+  uint8_t *data;
+  uint16_t len;
+} ilps22qs_spidev_txn_t;
+
+int32_t ilps22qs_spidev_open(ilps22qs_spidev_t *dev, const char *path,
+                             uint32_t speed_hz);
+void ilps22qs_spidev_close(ilps22qs_spidev_t *dev);
+int32_t ilps22qs_spidev_write(void *handle, uint8_t reg, const uint8_t *buf,
+                              uint16_t len);
+int32_t ilps22qs_spidev_read(void *handle, uint8_t reg, uint8_t *buf,
+                             uint16_t len);
+int32_t ilps22qs_spidev_batch(void *handle, const ilps22qs_spidev_txn_t *txn,
+                              uint8_t num);
+
+/**
+  * @}
+  *
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ILPS22QS_SPIDEV_H */
@@ -0,0 +1,35 @@
+/**
+  ******************************************************************************
+  * @file    ilps22qs_conf_template.h
+  * @author  Sensors Software Solution Team
+  * @brief   Feature selection template for the ilps22qs_reg.c driver and
+  *          the ilps22qs_proc.c processing.
+  *          Copy it as ilps22qs_conf.h in the application include path and
+  *          build with ILPS22QS_USE_CONF_H defined.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ILPS22QS_CONF_H
+#define ILPS22QS_CONF_H
+
+/* 1 -> feature group compiled in, 0 -> compiled out */
+#define ILPS22QS_FIFO_EN                 1
+#define ILPS22QS_QVAR_EN                 1
+#define ILPS22QS_INT_EN                  1
+#define ILPS22QS_REF_EN                  1
+#define ILPS22QS_BUS_CONF_EN             1
+#define ILPS22QS_FLOAT_EN                1
+#define ILPS22QS_PROC_EN                 0 /* ilps22qs_proc.c, libm */
+
+#endif /* ILPS22QS_CONF_H */
@@ -0,0 +1,4648 @@
+/**
+  ******************************************************************************
+  * @file    ilps22qs_proc.c
+  * @author  Sensors Software Solution Team
+  * @brief   ILPS22QS host-side processing of the driver output
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "ilps22qs_proc.h"
+#include <string.h>
+
+#if (ILPS22QS_PROC_EN != 0)
+/**
+  * @defgroup    ILPS22QS_Proc
+  * @brief       This file provides optional host-side processing of the
+  *              sensor output, built on the public ilps22qs_reg.c API.
+  *              It is compiled only with ILPS22QS_PROC_EN set to 1; with
+  *              ILPS22QS_FLOAT_EN set to 0 only the fixed-point functions
+  *              are available.
+  *              The code is portable scalar C99 for the targets of the
+  *              driver: no SIMD kernels are provided, loops are left to
+  *              the compiler.
+  *              Samples with no pressure (hpa <= 0, the AH_QVAR samples
+  *              of the interleaved mode) are skipped by every function
+  *              unless stated otherwise.
+  * @{
+  *
+  */
+
+#if (ILPS22QS_FLOAT_EN != 0)
+
+/**
+  * @defgroup    Proc_Private_functions
+  * @brief       Section collect the utility functions shared by the
+  *              processing APIs.
+  * @{
+  *
+  */
+
+typedef float_t (*ilps22qs_proc_conv_t)(int32_t lsb);
+
+static ilps22qs_proc_conv_t ilps22qs_proc_conv(ilps22qs_fs_t fs)
+{
+  ilps22qs_proc_conv_t conv;
+
+  switch (fs)
+  {
+    case ILPS22QS_1260hPa:
+      conv = ilps22qs_from_fs1260_to_hPa;
+      break;
+    case ILPS22QS_4060hPa:
+      conv = ilps22qs_from_fs4000_to_hPa;
+      break;
+    default:
+      conv = NULL;
+      break;
+  }
+
+  return conv;
+}
+
+static uint8_t ilps22qs_proc_is_press(const ilps22qs_fifo_data_t *data)
+{
+  return (data->hpa > 0.0f) ? 1U : 0U;
+}
+
+/*
+ * Decode one 24-bit FIFO word (XL, L, H) as ilps22qs_fifo_data_get() does:
+ * in interleaved mode bit 0 of XL tags an AH_QVAR sample.
+ */
+static void ilps22qs_proc_decode(const uint8_t *buff, uint8_t interleaved,
+                                 ilps22qs_proc_conv_t to_hpa,
+                                 ilps22qs_fifo_data_t *data)
+{
+  data->raw = (int32_t)buff[2];
+  data->raw = (data->raw * 256) + (int32_t)buff[1];
+  data->raw = (data->raw * 256) + (int32_t)buff[0];
+  data->raw = data->raw * 256;
+
+  if ((interleaved != 0U) && ((buff[0] & 0x1U) != 0U))
+  {
+    /* data is a AH_QVAR sample */
+    data->lsb = (data->raw / 256); /* shift 8bit left */
+    data->hpa = 0.0f;
+  }
+  else
+  {
+    /* data is a pressure sample */
+    data->hpa = (to_hpa != NULL) ? to_hpa(data->raw) : 0.0f;
+    data->lsb = 0;
+  }
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup     Altitude
+  * @brief        This section groups the functions converting pressure into
+  *               altitude with the barometric formula
+  *               h = 44330.77 * (1 - (p / qnh)^0.190263) [m]
+  * @{
+  *
+  */
+
+#define ILPS22QS_ALT_SCALE_M     44330.77f
+#define ILPS22QS_ALT_EXP         0.190263f
+
+/**
+  * @brief  Pressure to altitude, exact barometric formula.
+  *
+  * @param  hpa   pressure in hPa
+  * @param  qnh   reference pressure at sea level in hPa
+  * @retval       altitude in m
+  *
+  */
+float_t ilps22qs_from_hPa_to_m(float_t hpa, float_t qnh)
+{
+  return ILPS22QS_ALT_SCALE_M * (1.0f - powf(hpa / qnh, ILPS22QS_ALT_EXP));
+}
+
+/**
+  * @brief  Pressure to altitude, fast approximation.
+  *         (p / qnh) is split in m * 2^e (1 <= m < 2): 2^(0.190263 * e) is
+  *         taken from a table and m^0.190263 from a 5th order polynomial
+  *         (relative error 1.2e-6). The altitude error is below 0.1 m for
+  *         p / qnh in [0.125, 2), i.e. 260..1260 hPa with any realistic
+  *         QNH; outside that range the exact formula is used.
+  *
+  * @param  hpa   pressure in hPa
+  * @param  qnh   reference pressure at sea level in hPa
+  * @retval       altitude in m
+  *
+  */
+float_t ilps22qs_from_hPa_to_m_fast(float_t hpa, float_t qnh)
+{
+  /* 2^(0.190263 * e) for e = -3 .. 0 */
+  static const float_t pow2_tab[4] =
+  {
+    0.673248493f, 0.768157473f, 0.876445933f, 1.0f
+  };
+  float_t ratio, m, y;
+  int exp2;
+
+  ratio = hpa / qnh;
+  m = 2.0f * frexpf(ratio, &exp2);
+  exp2 -= 1;
+
+  if ((exp2 < -3) || (exp2 > 0))
+  {
+    return ilps22qs_from_hPa_to_m(hpa, qnh);
+  }
+
+  m -= 1.0f;
+  y = 0.00408617443f;
+  y = (y * m) - 0.0179611488f;
+  y = (y * m) + 0.0405018347f;
+  y = (y * m) - 0.0758250371f;
+  y = (y * m) + 0.190169699f;
+  y = (y * m) + 1.00000119f;
+
+  return ILPS22QS_ALT_SCALE_M * (1.0f - (y * pow2_tab[exp2 + 3]));
+}
+
+/**
+  * @brief  Convert a batch of FIFO pressure samples into altitude.
+  *         AH_QVAR samples return 0 m.
+  *
+  * @param  data  FIFO samples as returned by ilps22qs_fifo_data_get.(ptr)
+  * @param  num   number of samples
+  * @param  qnh   reference pressure at sea level in hPa
+  * @param  mode  ILPS22QS_ALT_EXACT / ILPS22QS_ALT_FAST
+  * @param  alt   altitude in m, num entries.(ptr)
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_altitude_get(const ilps22qs_fifo_data_t *data, uint16_t num,
+                              float_t qnh, ilps22qs_alt_mode_t mode,
+                              float_t *alt)
+{
+  uint16_t i;
+
+  if ((data == NULL) || (alt == NULL) || (qnh <= 0.0f))
+  {
+    return -1;
+  }
+
+  for (i = 0U; i < num; i++)
+  {
+    if (ilps22qs_proc_is_press(&data[i]) == 0U)
+    {
+      alt[i] = 0.0f;
+    }
+    else if (mode == ILPS22QS_ALT_FAST)
+    {
+      alt[i] = ilps22qs_from_hPa_to_m_fast(data[i].hpa, qnh);
+    }
+    else
+    {
+      alt[i] = ilps22qs_from_hPa_to_m(data[i].hpa, qnh);
+    }
+  }
+
+  return 0;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup     Digital filters
+  * @brief        This section groups the host-side filters that can be
+  *               cascaded on decoded FIFO batches in addition to the
+  *               on-chip averaging and LPF. Filter state is kept in a
+  *               caller-provided ilps22qs_filt_t (one per device), no
+  *               memory is allocated.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Output data rate in Hz.
+  *
+  * @param  odr   output data rate selection
+  * @retval       ODR in Hz (0 in one-shot mode)
+  *
+  */
+float_t ilps22qs_odr_to_hz(ilps22qs_odr_t odr)
+{
+  float_t hz;
+
+  switch (odr)
+  {
+    case ILPS22QS_1Hz:
+      hz = 1.0f;
+      break;
+    case ILPS22QS_4Hz:
+      hz = 4.0f;
+      break;
+    case ILPS22QS_10Hz:
+      hz = 10.0f;
+      break;
+    case ILPS22QS_25Hz:
+      hz = 25.0f;
+      break;
+    case ILPS22QS_50Hz:
+      hz = 50.0f;
+      break;
+    case ILPS22QS_75Hz:
+      hz = 75.0f;
+      break;
+    case ILPS22QS_100Hz:
+      hz = 100.0f;
+      break;
+    case ILPS22QS_200Hz:
+      hz = 200.0f;
+      break;
+    default:
+      hz = 0.0f;
+      break;
+  }
+
+  return hz;
+}
+
+/**
+  * @brief  Pressure sample rate in Hz: the ODR, halved in interleaved
+  *         mode where pressure takes every other FIFO slot.
+  *
+  * @param  md    conversion setting.(ptr)
+  * @retval       pressure samples per second (0 in one-shot mode)
+  *
+  */
+float_t ilps22qs_press_rate_hz(const ilps22qs_md_t *md)
+{
+  float_t hz = 0.0f;
+
+  if (md != NULL)
+  {
+    hz = ilps22qs_odr_to_hz(md->odr);
+    if (md->interleaved_mode != 0U)
+    {
+      hz *= 0.5f;
+    }
+  }
+
+  return hz;
+}
+
+/**
+  * @brief  Filter pipeline initialization (no stages).
+  *
+  * @param  filt  filter pipeline.(ptr)
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_filt_init(ilps22qs_filt_t *filt)
+{
+  if (filt == NULL)
+  {
+    return -1;
+  }
+
+  (void)memset(filt, 0, sizeof(ilps22qs_filt_t));
+
+  return 0;
+}
+
+/**
+  * @brief  Clear the filter history keeping the configured stages.
+  *
+  * @param  filt  filter pipeline.(ptr)
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_filt_reset(ilps22qs_filt_t *filt)
+{
+  ilps22qs_filt_stage_t *st;
+  uint8_t i;
+
+  if (filt == NULL)
+  {
+    return -1;
+  }
+
+  for (i = 0U; i < filt->num; i++)
+  {
+    st = &filt->stage[i];
+    st->biquad.z1 = 0.0f;
+    st->biquad.z2 = 0.0f;
+    (void)memset(st->mov_avg.buf, 0, sizeof(st->mov_avg.buf));
+    st->mov_avg.sum = 0.0f;
+    st->mov_avg.idx = 0U;
+    st->mov_avg.cnt = 0U;
+    st->kalman.x = 0.0f;
+    st->kalman.p = st->kalman.r;
+  }
+  filt->primed = 0U;
+  filt->offset = 0.0f;
+
+  return 0;
+}
+
+static ilps22qs_filt_stage_t *ilps22qs_filt_stage_new(ilps22qs_filt_t *filt,
+                                                      ilps22qs_filt_type_t type)
+{
+  ilps22qs_filt_stage_t *st = NULL;
+
+  if ((filt != NULL) && (filt->num < ILPS22QS_FILT_STAGES_MAX))
+  {
+    st = &filt->stage[filt->num];
+    (void)memset(st, 0, sizeof(ilps22qs_filt_stage_t));
+    st->type = type;
+    filt->num++;
+  }
+
+  return st;
+}
+
+/**
+  * @brief  Append a 2nd order Butterworth low-pass stage.
+  *
+  * @param  filt  filter pipeline.(ptr)
+  * @param  md    sensor conversion setting.(ptr)
+  * @param  fc_hz cut-off frequency in Hz (below half the pressure rate)
+  * @retval       0 -> no Error, -1 -> invalid parameters / no free stage
+  *
+  */
+int32_t ilps22qs_filt_biquad_add(ilps22qs_filt_t *filt,
+                                 const ilps22qs_md_t *md, float_t fc_hz)
+{
+  ilps22qs_filt_stage_t *st;
+  float_t fs, w0, cw, alpha, a0;
+
+  fs = ilps22qs_press_rate_hz(md);
+  if ((fs <= 0.0f) || (fc_hz <= 0.0f) || (fc_hz >= (fs / 2.0f)))
+  {
+    return -1;
+  }
+
+  st = ilps22qs_filt_stage_new(filt, ILPS22QS_FILT_BIQUAD);
+  if (st == NULL)
+  {
+    return -1;
+  }
+
+  /* bilinear transform, Q = 1 / sqrt(2) */
+  w0 = 6.28318531f * fc_hz / fs;
+  cw = cosf(w0);
+  alpha = sinf(w0) * 0.707106781f;
+  a0 = 1.0f + alpha;
+
+  st->biquad.b0 = ((1.0f - cw) / 2.0f) / a0;
+  st->biquad.b1 = (1.0f - cw) / a0;
+  st->biquad.b2 = st->biquad.b0;
+  st->biquad.a1 = (-2.0f * cw) / a0;
+  st->biquad.a2 = (1.0f - alpha) / a0;
+
+  return 0;
+}
+
+/**
+  * @brief  Append a moving average stage.
+  *
+  * @param  filt  filter pipeline.(ptr)
+  * @param  len   window length (1 .. ILPS22QS_FILT_MOV_AVG_MAX)
+  * @retval       0 -> no Error, -1 -> invalid parameters / no free stage
+  *
+  */
+int32_t ilps22qs_filt_mov_avg_add(ilps22qs_filt_t *filt, uint16_t len)
+{
+  ilps22qs_filt_stage_t *st;
+
+  if ((len == 0U) || (len > ILPS22QS_FILT_MOV_AVG_MAX))
+  {
+    return -1;
+  }
+
+  st = ilps22qs_filt_stage_new(filt, ILPS22QS_FILT_MOV_AVG);
+  if (st == NULL)
+  {
+    return -1;
+  }
+
+  st->mov_avg.len = len;
+
+  return 0;
+}
+
+/**
+  * @brief  Append a 1-D Kalman smoothing stage.
+  *
+  * @param  filt  filter pipeline.(ptr)
+  * @param  q     process noise variance in hPa^2 per sample
+  * @param  r     measurement noise variance in hPa^2
+  * @retval       0 -> no Error, -1 -> invalid parameters / no free stage
+  *
+  */
+int32_t ilps22qs_filt_kalman_add(ilps22qs_filt_t *filt, float_t q, float_t r)
+{
+  ilps22qs_filt_stage_t *st;
+
+  if ((q < 0.0f) || (r <= 0.0f))
+  {
+    return -1;
+  }
+
+  st = ilps22qs_filt_stage_new(filt, ILPS22QS_FILT_KALMAN);
+  if (st == NULL)
+  {
+    return -1;
+  }
+
+  st->kalman.q = q;
+  st->kalman.r = r;
+  st->kalman.p = r;
+
+  return 0;
+}
+
+static float_t ilps22qs_filt_stage_run(ilps22qs_filt_stage_t *st, float_t x)
+{
+  float_t y, k;
+
+  switch (st->type)
+  {
+    case ILPS22QS_FILT_BIQUAD:
+      /* direct form II transposed */
+      y = (st->biquad.b0 * x) + st->biquad.z1;
+      st->biquad.z1 = (st->biquad.b1 * x) - (st->biquad.a1 * y) + st->biquad.z2;
+      st->biquad.z2 = (st->biquad.b2 * x) - (st->biquad.a2 * y);
+      break;
+    case ILPS22QS_FILT_MOV_AVG:
+      st->mov_avg.sum += x - st->mov_avg.buf[st->mov_avg.idx];
+      st->mov_avg.buf[st->mov_avg.idx] = x;
+      st->mov_avg.idx++;
+      if (st->mov_avg.idx >= st->mov_avg.len)
+      {
+        st->mov_avg.idx = 0U;
+      }
+      if (st->mov_avg.cnt < st->mov_avg.len)
+      {
+        st->mov_avg.cnt++;
+      }
+      y = st->mov_avg.sum / (float_t)st->mov_avg.cnt;
+      break;
+    case ILPS22QS_FILT_KALMAN:
+      st->kalman.p += st->kalman.q;
+      k = st->kalman.p / (st->kalman.p + st->kalman.r);
+      st->kalman.x += k * (x - st->kalman.x);
+      st->kalman.p *= (1.0f - k);
+      y = st->kalman.x;
+      break;
+    default:
+      y = x;
+      break;
+  }
+
+  return y;
+}
+
+/**
+  * @brief  Run the filter pipeline in place on a batch of FIFO samples.
+  *
+  * @param  filt  filter pipeline.(ptr)
+  * @param  data  FIFO samples as returned by ilps22qs_fifo_data_get.(ptr)
+  * @param  num   number of samples
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_filt_apply(ilps22qs_filt_t *filt, ilps22qs_fifo_data_t *data,
+                            uint16_t num)
+{
+  uint16_t i;
+  uint8_t s;
+  float_t x;
+
+  if ((filt == NULL) || (data == NULL))
+  {
+    return -1;
+  }
+
+  for (i = 0U; i < num; i++)
+  {
+    if (ilps22qs_proc_is_press(&data[i]) != 0U)
+    {
+      if (filt->primed == 0U)
+      {
+        /* states start at rest on the first sample */
+        filt->offset = data[i].hpa;
+        filt->primed = 1U;
+      }
+
+      x = data[i].hpa - filt->offset;
+      for (s = 0U; s < filt->num; s++)
+      {
+        x = ilps22qs_filt_stage_run(&filt->stage[s], x);
+      }
+      data[i].hpa = x + filt->offset;
+    }
+  }
+
+  return 0;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup     Spike rejection
+  * @brief        This section groups the sliding window median used to
+  *               reject pressure transients not caught by the on-chip
+  *               anti-spike filter. The window is kept in a double heap
+  *               (max-heap below the median, min-heap above it) so that
+  *               every new sample costs O(log len); all the storage is
+  *               provided by the caller at init.
+  * @{
+  *
+  */
+
+#define ILPS22QS_MED_LEN_MAX     32767U
+
+/* heap slot i (from -len/2 to (len-1)/2, 0 is the median) */
+#define ILPS22QS_MED_HEAP(m, i)  ((m)->heap[(int32_t)((m)->len / 2U) + (i)])
+#define ILPS22QS_MED_MIN_CT(m)   (((int32_t)(m)->cnt - 1) / 2)
+#define ILPS22QS_MED_MAX_CT(m)   ((int32_t)(m)->cnt / 2)
+
+static uint8_t ilps22qs_med_less(const ilps22qs_median_t *med, int32_t i,
+                                 int32_t j)
+{
+  return (uint8_t)(med->data[ILPS22QS_MED_HEAP(med, i)] <
+                   med->data[ILPS22QS_MED_HEAP(med, j)]);
+}
+
+/* swap heap slots i and j if slot i is less than slot j */
+static uint8_t ilps22qs_med_cmp_exch(ilps22qs_median_t *med, int32_t i,
+                                     int32_t j)
+{
+  uint16_t tmp;
+
+  if (ilps22qs_med_less(med, i, j) == 0U)
+  {
+    return 0U;
+  }
+
+  tmp = ILPS22QS_MED_HEAP(med, i);
+  ILPS22QS_MED_HEAP(med, i) = ILPS22QS_MED_HEAP(med, j);
+  ILPS22QS_MED_HEAP(med, j) = tmp;
+  med->pos[ILPS22QS_MED_HEAP(med, i)] = (int16_t)i;
+  med->pos[ILPS22QS_MED_HEAP(med, j)] = (int16_t)j;
+
+  return 1U;
+}
+
+static void ilps22qs_med_min_down(ilps22qs_median_t *med, int32_t i)
+{
+  while (i <= ILPS22QS_MED_MIN_CT(med))
+  {
+    if ((i > 1) && (i < ILPS22QS_MED_MIN_CT(med)) &&
+        (ilps22qs_med_less(med, i + 1, i) != 0U))
+    {
+      i++;
+    }
+    if (ilps22qs_med_cmp_exch(med, i, i / 2) == 0U)
+    {
+      break;
+    }
+    i *= 2;
+  }
+}
+
+static void ilps22qs_med_max_down(ilps22qs_median_t *med, int32_t i)
+{
+  while (i >= -ILPS22QS_MED_MAX_CT(med))
+  {
+    if ((i < -1) && (i > -ILPS22QS_MED_MAX_CT(med)) &&
+        (ilps22qs_med_less(med, i, i - 1) != 0U))
+    {
+      i--;
+    }
+    if (ilps22qs_med_cmp_exch(med, i / 2, i) == 0U)
+    {
+      break;
+    }
+    i *= 2;
+  }
+}
+
+/* return 1 if the item reached the median slot */
+static uint8_t ilps22qs_med_min_up(ilps22qs_median_t *med, int32_t i)
+{
+  while ((i > 0) && (ilps22qs_med_cmp_exch(med, i, i / 2) != 0U))
+  {
+    i /= 2;
+  }
+
+  return (uint8_t)(i == 0);
+}
+
+static uint8_t ilps22qs_med_max_up(ilps22qs_median_t *med, int32_t i)
+{
+  while ((i < 0) && (ilps22qs_med_cmp_exch(med, i / 2, i) != 0U))
+  {
+    i /= 2;
+  }
+
+  return (uint8_t)(i == 0);
+}
+
+/**
+  * @brief  Sliding median initialization.
+  *
+  * @param  med     sliding median handler.(ptr)
+  * @param  data    window storage, len entries.(ptr)
+  * @param  pos     position storage, len entries.(ptr)
+  * @param  heap    heap storage, len entries.(ptr)
+  * @param  len     window length (1 .. 32767 samples)
+  * @param  th_hpa  spike threshold in hPa: samples farther than th_hpa
+  *                 from the window median are replaced by the median.
+  *                 With th_hpa <= 0 every sample is replaced by the median.
+  * @retval         0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_median_init(ilps22qs_median_t *med, float_t *data,
+                             int16_t *pos, uint16_t *heap, uint16_t len,
+                             float_t th_hpa)
+{
+  int32_t n;
+
+  if ((med == NULL) || (data == NULL) || (pos == NULL) || (heap == NULL) ||
+      (len == 0U) || (len > ILPS22QS_MED_LEN_MAX))
+  {
+    return -1;
+  }
+
+  med->data = data;
+  med->pos = pos;
+  med->heap = heap;
+  med->th_hpa = th_hpa;
+  med->len = len;
+  med->idx = 0U;
+  med->cnt = 0U;
+
+  /* window entries fill median, max-heap and min-heap slots alternately */
+  for (n = 0; n < (int32_t)len; n++)
+  {
+    med->data[n] = 0.0f;
+    med->pos[n] = (int16_t)(((n + 1) / 2) * (((n & 1) != 0) ? -1 : 1));
+    ILPS22QS_MED_HEAP(med, med->pos[n]) = (uint16_t)n;
+  }
+
+  return 0;
+}
+
+/**
+  * @brief  Push one pressure sample in the window.
+  *
+  * @param  med   sliding median handler.(ptr)
+  * @param  hpa   pressure sample in hPa
+  * @retval       median of the current window in hPa
+  *
+  */
+float_t ilps22qs_median_update(ilps22qs_median_t *med, float_t hpa)
+{
+  uint8_t is_new;
+  float_t old, ret;
+  int32_t p;
+
+  is_new = (uint8_t)(med->cnt < med->len);
+  p = med->pos[med->idx];
+  old = med->data[med->idx];
+  med->data[med->idx] = hpa;
+  med->idx++;
+  if (med->idx >= med->len)
+  {
+    med->idx = 0U;
+  }
+  if (is_new != 0U)
+  {
+    med->cnt++;
+  }
+
+  if (p > 0)
+  {
+    /* entry is in the min-heap */
+    if ((is_new == 0U) && (old < hpa))
+    {
+      ilps22qs_med_min_down(med, p * 2);
+    }
+    else if (ilps22qs_med_min_up(med, p) != 0U)
+    {
+      ilps22qs_med_max_down(med, -1);
+    }
+    else
+    {
+      /* heap order already restored */
+    }
+  }
+  else if (p < 0)
+  {
+    /* entry is in the max-heap */
+    if ((is_new == 0U) && (hpa < old))
+    {
+      ilps22qs_med_max_down(med, p * 2);
+    }
+    else if (ilps22qs_med_max_up(med, p) != 0U)
+    {
+      ilps22qs_med_min_down(med, 1);
+    }
+    else
+    {
+      /* heap order already restored */
+    }
+  }
+  else
+  {
+    /* entry is the median */
+    if (ILPS22QS_MED_MAX_CT(med) != 0)
+    {
+      ilps22qs_med_max_down(med, -1);
+    }
+    if (ILPS22QS_MED_MIN_CT(med) != 0)
+    {
+      ilps22qs_med_min_down(med, 1);
+    }
+  }
+
+  ret = med->data[ILPS22QS_MED_HEAP(med, 0)];
+  if ((med->cnt & 1U) == 0U)
+  {
+    ret = (ret + med->data[ILPS22QS_MED_HEAP(med, -1)]) / 2.0f;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Spike rejection in place on a batch of FIFO samples.
+  *
+  * @param  med   sliding median handler.(ptr)
+  * @param  data  FIFO samples as returned by ilps22qs_fifo_data_get.(ptr)
+  * @param  num   number of samples
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_median_apply(ilps22qs_median_t *med,
+                              ilps22qs_fifo_data_t *data, uint16_t num)
+{
+  float_t median;
+  uint16_t i;
+
+  if ((med == NULL) || (med->len == 0U) || (data == NULL))
+  {
+    return -1;
+  }
+
+  for (i = 0U; i < num; i++)
+  {
+    if (ilps22qs_proc_is_press(&data[i]) != 0U)
+    {
+      median = ilps22qs_median_update(med, data[i].hpa);
+      if ((med->th_hpa <= 0.0f) || (fabsf(data[i].hpa - median) > med->th_hpa))
+      {
+        data[i].hpa = median;
+      }
+    }
+  }
+
+  return 0;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup     Statistics
+  * @brief        This section groups the incremental statistics on decoded
+  *               pressure: Welford mean / variance accumulators, mergeable
+  *               across batches and sensors, and exact min / max over a
+  *               sliding window of samples (monotonic deques).
+  * @{
+  *
+  */
+
+/**
+  * @brief  Statistics accumulator initialization.
+  *
+  * @param  stats accumulator.(ptr)
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_stats_init(ilps22qs_stats_t *stats)
+{
+  if (stats == NULL)
+  {
+    return -1;
+  }
+
+  (void)memset(stats, 0, sizeof(ilps22qs_stats_t));
+
+  return 0;
+}
+
+/**
+  * @brief  Accumulate a batch of FIFO samples.
+  *
+  * @param  stats accumulator.(ptr)
+  * @param  data  FIFO samples as returned by ilps22qs_fifo_data_get.(ptr)
+  * @param  num   number of samples
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_stats_add(ilps22qs_stats_t *stats,
+                           const ilps22qs_fifo_data_t *data, uint16_t num)
+{
+  float_t x, delta;
+  uint16_t i;
+
+  if ((stats == NULL) || (data == NULL))
+  {
+    return -1;
+  }
+
+  for (i = 0U; i < num; i++)
+  {
+    if (ilps22qs_proc_is_press(&data[i]) != 0U)
+    {
+      x = data[i].hpa;
+      if (stats->n == 0U)
+      {
+        stats->min = x;
+        stats->max = x;
+        stats->first = x;
+      }
+      stats->n++;
+      x -= stats->first;
+      delta = x - stats->mean_dev;
+      stats->mean_dev += delta / (float_t)stats->n;
+      stats->m2 += delta * (x - stats->mean_dev);
+      x += stats->first;
+      stats->min = (x < stats->min) ? x : stats->min;
+      stats->max = (x > stats->max) ? x : stats->max;
+      stats->last = x;
+    }
+  }
+
+  return 0;
+}
+
+/**
+  * @brief  Merge an accumulator into another one (Chan et al.).
+  *         For the rate of change, next is assumed to follow stats in time.
+  *
+  * @param  stats accumulator updated with the merged values.(ptr)
+  * @param  next  accumulator to merge.(ptr)
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_stats_merge(ilps22qs_stats_t *stats,
+                             const ilps22qs_stats_t *next)
+{
+  float_t na, nb, n, delta;
+
+  if ((stats == NULL) || (next == NULL))
+  {
+    return -1;
+  }
+
+  if (next->n == 0U)
+  {
+    return 0;
+  }
+
+  if (stats->n == 0U)
+  {
+    *stats = *next;
+    return 0;
+  }
+
+  na = (float_t)stats->n;
+  nb = (float_t)next->n;
+  n = na + nb;
+  delta = (next->first - stats->first) + (next->mean_dev - stats->mean_dev);
+
+  stats->mean_dev += delta * (nb / n);
+  stats->m2 += next->m2 + (delta * delta * (na * nb / n));
+  stats->n += next->n;
+  stats->min = (next->min < stats->min) ? next->min : stats->min;
+  stats->max = (next->max > stats->max) ? next->max : stats->max;
+  stats->last = next->last;
+
+  return 0;
+}
+
+/**
+  * @brief  Mean value.
+  *
+  * @param  stats accumulator.(ptr)
+  * @retval       mean in hPa (0 if no samples)
+  *
+  */
+float_t ilps22qs_stats_mean(const ilps22qs_stats_t *stats)
+{
+  float_t mean = 0.0f;
+
+  if ((stats != NULL) && (stats->n > 0U))
+  {
+    mean = stats->first + stats->mean_dev;
+  }
+
+  return mean;
+}
+
+/**
+  * @brief  Sample variance.
+  *
+  * @param  stats accumulator.(ptr)
+  * @retval       variance in hPa^2 (0 with less than two samples)
+  *
+  */
+float_t ilps22qs_stats_variance(const ilps22qs_stats_t *stats)
+{
+  float_t var = 0.0f;
+
+  if ((stats != NULL) && (stats->n > 1U))
+  {
+    var = stats->m2 / (float_t)(stats->n - 1U);
+  }
+
+  return var;
+}
+
+/**
+  * @brief  Average rate of change between the oldest and the newest sample.
+  *
+  * @param  stats accumulator.(ptr)
+  * @param  md    sensor conversion setting.(ptr)
+  * @retval       rate of change in hPa/s (0 if not computable)
+  *
+  */
+float_t ilps22qs_stats_rate(const ilps22qs_stats_t *stats,
+                            const ilps22qs_md_t *md)
+{
+  float_t rate = 0.0f;
+
+  if ((stats != NULL) && (stats->n > 1U))
+  {
+    rate = (stats->last - stats->first) * ilps22qs_press_rate_hz(md) /
+           (float_t)(stats->n - 1U);
+  }
+
+  return rate;
+}
+
+/**
+  * @brief  Sliding window min / max initialization.
+  *
+  * @param  mm    sliding min / max handler.(ptr)
+  * @param  min_q deque storage for the minimum, len entries.(ptr)
+  * @param  max_q deque storage for the maximum, len entries.(ptr)
+  * @param  len   window length in samples
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_minmax_init(ilps22qs_minmax_t *mm,
+                             ilps22qs_minmax_item_t *min_q,
+                             ilps22qs_minmax_item_t *max_q, uint16_t len)
+{
+  if ((mm == NULL) || (min_q == NULL) || (max_q == NULL) || (len == 0U))
+  {
+    return -1;
+  }
+
+  (void)memset(mm, 0, sizeof(ilps22qs_minmax_t));
+  mm->min_q = min_q;
+  mm->max_q = max_q;
+  mm->len = len;
+
+  return 0;
+}
+
+/*
+ * Push x in a monotonic deque: entries that can no longer be the extreme
+ * are dropped from the back, expired entries from the front.
+ * is_min selects an increasing (min) or decreasing (max) deque.
+ */
+static void ilps22qs_minmax_push(ilps22qs_minmax_item_t *q, uint16_t len,
+                                 uint16_t *head, uint16_t *cnt, uint32_t seq,
+                                 float_t x, uint8_t is_min)
+{
+  uint16_t back;
+
+  while (*cnt > 0U)
+  {
+    back = (uint16_t)((*head + *cnt - 1U) % len);
+    if (((is_min != 0U) && (q[back].val < x)) ||
+        ((is_min == 0U) && (q[back].val > x)))
+    {
+      break;
+    }
+    (*cnt)--;
+  }
+
+  while ((*cnt > 0U) && ((seq - q[*head].seq) >= len))
+  {
+    *head = (uint16_t)((*head + 1U) % len);
+    (*cnt)--;
+  }
+
+  back = (uint16_t)((*head + *cnt) % len);
+  q[back].val = x;
+  q[back].seq = seq;
+  (*cnt)++;
+}
+
+/**
+  * @brief  Push a batch of FIFO samples in the sliding window.
+  *
+  * @param  mm    sliding min / max handler.(ptr)
+  * @param  data  FIFO samples as returned by ilps22qs_fifo_data_get.(ptr)
+  * @param  num   number of samples
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_minmax_add(ilps22qs_minmax_t *mm,
+                            const ilps22qs_fifo_data_t *data, uint16_t num)
+{
+  uint16_t i;
+
+  if ((mm == NULL) || (mm->len == 0U) || (data == NULL))
+  {
+    return -1;
+  }
+
+  for (i = 0U; i < num; i++)
+  {
+    if (ilps22qs_proc_is_press(&data[i]) != 0U)
+    {
+      ilps22qs_minmax_push(mm->min_q, mm->len, &mm->min_head, &mm->min_cnt,
+                           mm->seq, data[i].hpa, 1U);
+      ilps22qs_minmax_push(mm->max_q, mm->len, &mm->max_head, &mm->max_cnt,
+                           mm->seq, data[i].hpa, 0U);
+      mm->seq++;
+    }
+  }
+
+  return 0;
+}
+
+/**
+  * @brief  Minimum and maximum over the last len samples.
+  *
+  * @param  mm    sliding min / max handler.(ptr)
+  * @param  min   minimum in hPa.(ptr)
+  * @param  max   maximum in hPa.(ptr)
+  * @retval       0 -> no Error, -1 -> invalid parameters / empty window
+  *
+  */
+int32_t ilps22qs_minmax_get(const ilps22qs_minmax_t *mm, float_t *min,
+                            float_t *max)
+{
+  if ((mm == NULL) || (min == NULL) || (max == NULL) || (mm->min_cnt == 0U))
+  {
+    return -1;
+  }
+
+  *min = mm->min_q[mm->min_head].val;
+  *max = mm->max_q[mm->max_head].val;
+
+  return 0;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup     Allan deviation
+  * @brief        This section groups the streaming Allan deviation
+  *               analyzer used to compare AVG / ODR / LPF settings on
+  *               live data. Non-overlapping block averages of 2^k samples
+  *               are built by pairwise decimation, one state per octave,
+  *               so memory is O(log N) in the number of samples.
+  * @{
+  *
+  */
+
+/* minimum number of differences for a level to be reported as floor */
+#define ILPS22QS_ALLAN_MIN_CNT   4U
+
+/* samples discarded after each configuration change in the sweep */
+#define ILPS22QS_ALLAN_SETTLE    8U
+
+/**
+  * @brief  Allan deviation analyzer initialization.
+  *
+  * @param  allan analyzer.(ptr)
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_allan_init(ilps22qs_allan_t *allan)
+{
+  if (allan == NULL)
+  {
+    return -1;
+  }
+
+  (void)memset(allan, 0, sizeof(ilps22qs_allan_t));
+
+  return 0;
+}
+
+/**
+  * @brief  Feed a batch of FIFO samples to the analyzer.
+  *
+  * @param  allan analyzer.(ptr)
+  * @param  data  FIFO samples as returned by ilps22qs_fifo_data_get.(ptr)
+  * @param  num   number of samples
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_allan_add(ilps22qs_allan_t *allan,
+                           const ilps22qs_fifo_data_t *data, uint16_t num)
+{
+  float_t y, d;
+  uint16_t i;
+  uint8_t k;
+
+  if ((allan == NULL) || (data == NULL))
+  {
+    return -1;
+  }
+
+  for (i = 0U; i < num; i++)
+  {
+    if (ilps22qs_proc_is_press(&data[i]) != 0U)
+    {
+      if (allan->primed == 0U)
+      {
+        allan->offset = data[i].hpa;
+        allan->primed = 1U;
+      }
+
+      /* propagate the new block average up while pairs complete */
+      y = data[i].hpa - allan->offset;
+      for (k = 0U; k < ILPS22QS_ALLAN_LEVELS; k++)
+      {
+        if (allan->level[k].has_prev != 0U)
+        {
+          d = y - allan->level[k].prev;
+          allan->level[k].acc += d * d;
+          allan->level[k].cnt++;
+        }
+        allan->level[k].prev = y;
+        allan->level[k].has_prev = 1U;
+
+        if (allan->level[k].has_pend == 0U)
+        {
+          allan->level[k].pend = y;
+          allan->level[k].has_pend = 1U;
+          break;
+        }
+        y = (allan->level[k].pend + y) / 2.0f;
+        allan->level[k].has_pend = 0U;
+      }
+    }
+  }
+
+  return 0;
+}
+
+/**
+  * @brief  Allan deviation at one octave.
+  *
+  * @param  allan analyzer.(ptr)
+  * @param  level octave index: tau = 2^level pressure samples
+  * @param  md    sensor conversion setting.(ptr)
+  * @param  tau_s averaging time in s.(ptr)
+  * @param  adev  Allan deviation in hPa.(ptr)
+  * @retval       0 -> no Error, -1 -> invalid parameters / no data yet
+  *
+  */
+int32_t ilps22qs_allan_dev_get(const ilps22qs_allan_t *allan, uint8_t level,
+                               const ilps22qs_md_t *md, float_t *tau_s,
+                               float_t *adev)
+{
+  float_t hz;
+
+  hz = ilps22qs_press_rate_hz(md);
+  if ((allan == NULL) || (tau_s == NULL) || (adev == NULL) ||
+      (level >= ILPS22QS_ALLAN_LEVELS) || (hz <= 0.0f) ||
+      (allan->level[level].cnt == 0U))
+  {
+    return -1;
+  }
+
+  *tau_s = (float_t)((uint32_t)1U << level) / hz;
+  *adev = sqrtf(allan->level[level].acc /
+                (2.0f * (float_t)allan->level[level].cnt));
+
+  return 0;
+}
+
+/**
+  * @brief  Noise floor: minimum Allan deviation over the octaves having
+  *         at least ILPS22QS_ALLAN_MIN_CNT differences.
+  *
+  * @param  allan analyzer.(ptr)
+  * @param  md    sensor conversion setting.(ptr)
+  * @param  tau_s averaging time of the minimum in s.(ptr)
+  * @param  adev  minimum Allan deviation in hPa.(ptr)
+  * @retval       0 -> no Error, -1 -> invalid parameters / not enough data
+  *
+  */
+int32_t ilps22qs_allan_floor_get(const ilps22qs_allan_t *allan,
+                                 const ilps22qs_md_t *md, float_t *tau_s,
+                                 float_t *adev)
+{
+  float_t tau, dev;
+  int32_t ret = -1;
+  uint8_t k;
+
+  if ((allan == NULL) || (tau_s == NULL) || (adev == NULL))
+  {
+    return -1;
+  }
+
+  for (k = 0U; k < ILPS22QS_ALLAN_LEVELS; k++)
+  {
+    if ((allan->level[k].cnt >= ILPS22QS_ALLAN_MIN_CNT) &&
+        (ilps22qs_allan_dev_get(allan, k, md, &tau, &dev) == 0))
+    {
+      if ((ret != 0) || (dev < *adev))
+      {
+        *tau_s = tau;
+        *adev = dev;
+        ret = 0;
+      }
+    }
+  }
+
+  return ret;
+}
+
+#if (ILPS22QS_FIFO_EN != 0)
+/**
+  * @brief  Sweep a list of conversion settings and analyze each of them.
+  *         For every entry the sensor is configured with
+  *         ilps22qs_mode_set, the FIFO is run in stream mode and
+  *         "samples" pressure samples are fed to allan[i] (the first
+  *         ILPS22QS_ALLAN_SETTLE samples are discarded). ctx->mdelay is
+  *         mandatory; FIFO is left in bypass mode.
+  *
+  * @param  ctx     communication interface handler.(ptr)
+  * @param  md      list of conversion settings, ODR not one-shot.(ptr)
+  * @param  num     number of settings
+  * @param  samples number of samples to analyze per setting
+  * @param  allan   one analyzer per setting.(ptr)
+  * @retval         interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps22qs_allan_sweep(const stmdev_ctx_t *ctx, ilps22qs_md_t *md,
+                             uint8_t num, uint32_t samples,
+                             ilps22qs_allan_t *allan)
+{
+  ilps22qs_fifo_data_t data[32];
+  uint32_t got, skip, idle_ms;
+  uint8_t i, level, n;
+  uint32_t period_ms;
+  int32_t ret = 0;
+
+  if ((ctx == NULL) || (ctx->mdelay == NULL) || (md == NULL) ||
+      (allan == NULL))
+  {
+    return -1;
+  }
+
+  for (i = 0U; (i < num) && (ret == 0); i++)
+  {
+    if (md[i].odr == ILPS22QS_ONE_SHOT)
+    {
+      ret = -1;
+      break;
+    }
+    period_ms = (uint32_t)(1000.0f / ilps22qs_odr_to_hz(md[i].odr));
+    period_ms = (period_ms == 0U) ? 1U : period_ms;
+
+    ret = ilps22qs_allan_init(&allan[i]);
+    ret += ilps22qs_fifo_mode_set(ctx, ILPS22QS_BYPASS);
+    ret += ilps22qs_mode_set(ctx, &md[i]);
+    ret += ilps22qs_fifo_mode_set(ctx, ILPS22QS_STREAM);
+
+    got = 0U;
+    skip = ILPS22QS_ALLAN_SETTLE;
+    idle_ms = 0U;
+    while ((ret == 0) && (got < samples))
+    {
+      ret = ilps22qs_fifo_level_get(ctx, &level);
+      if ((ret == 0) && (level == 0U))
+      {
+        /* no data within 2 s or 10 periods: sensor not running */
+        if ((idle_ms > 2000U) && (idle_ms > (10U * period_ms)))
+        {
+          ret = -1;
+        }
+        ctx->mdelay(period_ms);
+        idle_ms += period_ms;
+      }
+      else if (ret == 0)
+      {
+        idle_ms = 0U;
+        n = (level > 32U) ? 32U : level;
+        ret = ilps22qs_fifo_data_get(ctx, n, &md[i], data);
+        if (ret == 0)
+        {
+          if (skip >= n)
+          {
+            skip -= n;
+          }
+          else
+          {
+            n -= (uint8_t)skip;
+            n = ((samples - got) < n) ? (uint8_t)(samples - got) : n;
+            ret = ilps22qs_allan_add(&allan[i], &data[skip], n);
+            got += n;
+            skip = 0U;
+          }
+        }
+      }
+      else
+      {
+        /* interface error */
+      }
+    }
+  }
+
+  ret += ilps22qs_fifo_mode_set(ctx, ILPS22QS_BYPASS);
+
+  return ret;
+}
+#endif /* ILPS22QS_FIFO_EN */
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup     Sample log
+  * @brief        This section groups the functions packing FIFO samples
+  *               into fixed-size, checksummed log blocks: 3 bytes per
+  *               sample (the raw FIFO word, AH_QVAR tag included) and one
+  *               timestamp + period per block. A full block is handed to
+  *               the user flush routine, i.e. to be appended to a file or
+  *               a flash page; the block sequence number and timestamp
+  *               make the log indexable by block.
+  *               The reader works on a log image in memory (i.e. a
+  *               memory-mapped file), keeps a per-device block index and
+  *               decodes only the blocks of the requested time range.
+  * @{
+  *
+  */
+
+static void ilps22qs_put_u16(uint8_t *buf, uint16_t val)
+{
+  buf[0] = (uint8_t)(val & 0xFFU);
+  buf[1] = (uint8_t)(val >> 8);
+}
+
+static void ilps22qs_put_u32(uint8_t *buf, uint32_t val)
+{
+  ilps22qs_put_u16(&buf[0], (uint16_t)(val & 0xFFFFU));
+  ilps22qs_put_u16(&buf[2], (uint16_t)(val >> 16));
+}
+
+static uint16_t ilps22qs_get_u16(const uint8_t *buf)
+{
+  return (uint16_t)((uint16_t)buf[0] | ((uint16_t)buf[1] << 8));
+}
+
+static uint32_t ilps22qs_get_u32(const uint8_t *buf)
+{
+  return (uint32_t)ilps22qs_get_u16(&buf[0]) |
+         ((uint32_t)ilps22qs_get_u16(&buf[2]) << 16);
+}
+
+static void ilps22qs_put_u64(uint8_t *buf, uint64_t val)
+{
+  ilps22qs_put_u32(&buf[0], (uint32_t)(val & 0xFFFFFFFFU));
+  ilps22qs_put_u32(&buf[4], (uint32_t)(val >> 32));
+}
+
+static uint64_t ilps22qs_get_u64(const uint8_t *buf)
+{
+  return (uint64_t)ilps22qs_get_u32(&buf[0]) |
+         ((uint64_t)ilps22qs_get_u32(&buf[4]) << 32);
+}
+
+/* CRC-32 (IEEE 802.3), nibble table; the CRC field is taken as 0 */
+static uint32_t ilps22qs_log_crc(const uint8_t *block)
+{
+  static const uint32_t tab[16] =
+  {
+    0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU,
+    0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+    0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU,
+    0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU,
+  };
+  uint32_t crc = 0xFFFFFFFFU;
+  uint16_t i;
+  uint8_t b;
+
+  for (i = 0U; i < ILPS22QS_LOG_BLOCK_SIZE; i++)
+  {
+    b = ((i >= 24U) && (i < 28U)) ? 0U : block[i];
+    crc = (crc >> 4) ^ tab[(crc ^ b) & 0x0FU];
+    crc = (crc >> 4) ^ tab[(crc ^ ((uint32_t)b >> 4)) & 0x0FU];
+  }
+
+  return ~crc;
+}
+
+/**
+  * @brief  Sample log initialization.
+  *
+  * @param  log     log writer.(ptr)
+  * @param  dev_id  device identifier stored in every block
+  * @param  dt      sample period in ticks (ILPS22QS_LOG_TICK_HZ)
+  * @param  flush   routine storing a complete block.(ptr)
+  * @param  handle  customizable pointer passed to flush.(ptr)
+  * @retval         0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_log_init(ilps22qs_log_t *log, uint8_t dev_id, uint32_t dt,
+                          ilps22qs_log_flush_ptr flush, void *handle)
+{
+  if ((log == NULL) || (flush == NULL) || (dt == 0U))
+  {
+    return -1;
+  }
+
+  (void)memset(log, 0, sizeof(ilps22qs_log_t));
+  log->flush = flush;
+  log->handle = handle;
+  log->hdr.dev_id = dev_id;
+  log->hdr.dt = dt;
+
+  return 0;
+}
+
+/**
+  * @brief  Close the current block (if not empty) and pass it to flush.
+  *         On a flush error the block is kept with the same sequence
+  *         number and is passed again by the next call.
+  *
+  * @param  log   log writer.(ptr)
+  * @retval       flush status (0 -> no Error)
+  *
+  */
+int32_t ilps22qs_log_flush(ilps22qs_log_t *log)
+{
+  int32_t ret = 0;
+
+  if (log == NULL)
+  {
+    return -1;
+  }
+
+  if (log->hdr.cnt != 0U)
+  {
+    log->block[0] = 0x51U;
+    log->block[1] = 0x50U;
+    log->block[2] = ILPS22QS_LOG_VERSION;
+    log->block[3] = log->hdr.dev_id;
+    ilps22qs_put_u32(&log->block[4], log->hdr.seq);
+    ilps22qs_put_u64(&log->block[8], log->hdr.t0);
+    ilps22qs_put_u32(&log->block[16], log->hdr.dt);
+    ilps22qs_put_u16(&log->block[20], log->hdr.cnt);
+    ilps22qs_put_u16(&log->block[22], 0U);
+    ilps22qs_put_u32(&log->block[24], 0U);
+    (void)memset(&log->block[ILPS22QS_LOG_HDR_SIZE + (3U * log->hdr.cnt)], 0,
+                 ILPS22QS_LOG_BLOCK_SIZE - ILPS22QS_LOG_HDR_SIZE -
+                 (3U * log->hdr.cnt));
+    ilps22qs_put_u32(&log->block[24], ilps22qs_log_crc(log->block));
+
+    ret = log->flush(log->handle, log->block, ILPS22QS_LOG_BLOCK_SIZE);
+    if (ret == 0)
+    {
+      log->hdr.seq++;
+      log->hdr.cnt = 0U;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Append a batch of FIFO samples to the log.
+  *         A new block is started when the current one is full or when t
+  *         does not follow the last logged sample by one period. A block
+  *         left by a failed flush is flushed first; on a flush error the
+  *         samples of the batch not yet in the block are dropped.
+  *
+  * @param  log   log writer.(ptr)
+  * @param  t     timestamp of data[0] in ticks; next samples are t + i * dt
+  * @param  data  FIFO samples as returned by ilps22qs_fifo_data_get.(ptr)
+  * @param  num   number of samples
+  * @retval       flush status (0 -> no Error)
+  *
+  */
+int32_t ilps22qs_log_append(ilps22qs_log_t *log, uint64_t t,
+                            const ilps22qs_fifo_data_t *data, uint16_t num)
+{
+  uint32_t word;
+  uint8_t *rec;
+  int32_t ret = 0;
+  uint16_t i;
+
+  if ((log == NULL) || (data == NULL))
+  {
+    return -1;
+  }
+
+  if ((log->hdr.cnt >= ILPS22QS_LOG_SAMPLES) || ((log->hdr.cnt != 0U) &&
+      (t != (log->hdr.t0 + ((uint64_t)log->hdr.cnt * log->hdr.dt)))))
+  {
+    ret = ilps22qs_log_flush(log);
+  }
+
+  for (i = 0U; (i < num) && (ret == 0); i++)
+  {
+    if (log->hdr.cnt == 0U)
+    {
+      log->hdr.t0 = t + ((uint64_t)i * log->hdr.dt);
+    }
+
+    /* raw is the FIFO word left-aligned on 32 bit */
+    word = (uint32_t)data[i].raw >> 8;
+    rec = &log->block[ILPS22QS_LOG_HDR_SIZE + (3U * log->hdr.cnt)];
+    rec[0] = (uint8_t)(word & 0xFFU);
+    rec[1] = (uint8_t)((word >> 8) & 0xFFU);
+    rec[2] = (uint8_t)((word >> 16) & 0xFFU);
+    log->hdr.cnt++;
+
+    if (log->hdr.cnt >= ILPS22QS_LOG_SAMPLES)
+    {
+      ret = ilps22qs_log_flush(log);
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Validate a log block and decode its header.
+  *
+  * @param  block log block, ILPS22QS_LOG_BLOCK_SIZE bytes.(ptr)
+  * @param  hdr   decoded header.(ptr)
+  * @retval       0 -> valid block, -1 -> bad magic / version / CRC
+  *
+  */
+int32_t ilps22qs_log_block_check(const uint8_t *block, ilps22qs_log_hdr_t *hdr)
+{
+  if ((block == NULL) || (hdr == NULL) || (block[0] != 0x51U) ||
+      (block[1] != 0x50U) || (block[2] != ILPS22QS_LOG_VERSION) ||
+      (ilps22qs_get_u32(&block[24]) != ilps22qs_log_crc(block)))
+  {
+    return -1;
+  }
+
+  hdr->dev_id = block[3];
+  hdr->seq = ilps22qs_get_u32(&block[4]);
+  hdr->t0 = ilps22qs_get_u64(&block[8]);
+  hdr->dt = ilps22qs_get_u32(&block[16]);
+  hdr->cnt = ilps22qs_get_u16(&block[20]);
+
+  if ((hdr->cnt > ILPS22QS_LOG_SAMPLES) || (hdr->dt == 0U))
+  {
+    return -1;
+  }
+
+  return 0;
+}
+
+/**
+  * @brief  Build the time index of one device over a log image.
+  *         Only block headers are read; CRC is verified when a block is
+  *         decoded. Blocks of one device must be in time order, the range
+  *         search relies on it.
+  *
+  * @param  rd      log reader.(ptr)
+  * @param  log     log image, i.e. a memory-mapped log file.(ptr)
+  * @param  size    log image size in bytes
+  * @param  dev_id  device to index
+  * @param  idx     index storage.(ptr)
+  * @param  idx_max index storage entries
+  * @retval         0 -> no Error, -1 -> invalid parameters / index full /
+  *                 blocks out of time order
+  *
+  */
+int32_t ilps22qs_log_reader_init(ilps22qs_log_reader_t *rd, const uint8_t *log,
+                                 size_t size, uint8_t dev_id,
+                                 ilps22qs_log_idx_t *idx, uint32_t idx_max)
+{
+  const uint8_t *blk;
+  uint16_t cnt;
+  uint32_t b, dt;
+  uint64_t t0;
+
+  if ((rd == NULL) || (log == NULL) || (idx == NULL) ||
+      ((uint64_t)(size / ILPS22QS_LOG_BLOCK_SIZE) > 0xFFFFFFFFU))
+  {
+    return -1;
+  }
+
+  rd->log = log;
+  rd->blocks = size / ILPS22QS_LOG_BLOCK_SIZE;
+  rd->idx = idx;
+  rd->idx_cnt = 0U;
+  rd->dev_id = dev_id;
+
+  for (b = 0U; b < rd->blocks; b++)
+  {
+    blk = &log[(size_t)b * ILPS22QS_LOG_BLOCK_SIZE];
+    cnt = ilps22qs_get_u16(&blk[20]);
+    if ((blk[0] == 0x51U) && (blk[1] == 0x50U) &&
+        (blk[2] == ILPS22QS_LOG_VERSION) && (blk[3] == dev_id) &&
+        (cnt != 0U) && (cnt <= ILPS22QS_LOG_SAMPLES))
+    {
+      if (rd->idx_cnt >= idx_max)
+      {
+        return -1;
+      }
+      t0 = ilps22qs_get_u64(&blk[8]);
+      dt = ilps22qs_get_u32(&blk[16]);
+      if ((rd->idx_cnt != 0U) && (t0 <= idx[rd->idx_cnt - 1U].t_end))
+      {
+        return -1;
+      }
+      idx[rd->idx_cnt].block = b;
+      idx[rd->idx_cnt].t0 = t0;
+      idx[rd->idx_cnt].t_end = t0 + ((uint64_t)(cnt - 1U) * dt);
+      rd->idx_cnt++;
+    }
+  }
+
+  return 0;
+}
+
+/**
+  * @brief  Start an iteration over the samples in [t1, t2].
+  *
+  * @param  rd    log reader.(ptr)
+  * @param  t1    first timestamp
+  * @param  t2    last timestamp
+  * @param  it    iterator.(ptr)
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_log_range_first(const ilps22qs_log_reader_t *rd, uint64_t t1,
+                                 uint64_t t2, ilps22qs_log_iter_t *it)
+{
+  uint32_t lo, hi, mid;
+
+  if ((rd == NULL) || (it == NULL) || (t2 < t1))
+  {
+    return -1;
+  }
+
+  /* first block ending at or after t1 */
+  lo = 0U;
+  hi = rd->idx_cnt;
+  while (lo < hi)
+  {
+    mid = lo + ((hi - lo) / 2U);
+    if (rd->idx[mid].t_end < t1)
+    {
+      lo = mid + 1U;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  it->pos = lo;
+  it->t1 = t1;
+  it->t2 = t2;
+
+  return 0;
+}
+
+/**
+  * @brief  Decode the next block of samples in the iteration range.
+  *         Raw words are read in place from the log image and converted
+  *         with the full scale / interleaved mode in md.
+  *
+  * @param  rd    log reader.(ptr)
+  * @param  it    iterator.(ptr)
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  data  decoded samples, ILPS22QS_LOG_SAMPLES entries.(ptr)
+  * @param  t0    timestamp of data[0].(ptr)
+  * @param  num   number of decoded samples, 0 at the end of range.(ptr)
+  * @retval       0 -> no Error, -1 -> invalid parameters / corrupted block
+  *
+  */
+int32_t ilps22qs_log_range_next(const ilps22qs_log_reader_t *rd,
+                                ilps22qs_log_iter_t *it, ilps22qs_md_t *md,
+                                ilps22qs_fifo_data_t *data, uint64_t *t0,
+                                uint16_t *num)
+{
+  ilps22qs_log_hdr_t hdr;
+  const uint8_t *blk;
+  uint64_t first, last;
+  uint8_t interleaved;
+  ilps22qs_proc_conv_t to_hpa;
+  uint32_t i;
+
+  if ((rd == NULL) || (it == NULL) || (md == NULL) || (data == NULL) ||
+      (t0 == NULL) || (num == NULL))
+  {
+    return -1;
+  }
+
+  *num = 0U;
+  if ((it->pos >= rd->idx_cnt) || (rd->idx[it->pos].t0 > it->t2))
+  {
+    return 0;
+  }
+
+  blk = &rd->log[(size_t)rd->idx[it->pos].block * ILPS22QS_LOG_BLOCK_SIZE];
+  it->pos++;
+  if (ilps22qs_log_block_check(blk, &hdr) != 0)
+  {
+    return -1;
+  }
+
+  /* samples of this block inside [t1, t2] */
+  first = 0U;
+  if (it->t1 > hdr.t0)
+  {
+    first = ((it->t1 - hdr.t0) + hdr.dt - 1U) / hdr.dt;
+  }
+  last = (uint64_t)hdr.cnt - 1U;
+  if (((it->t2 - hdr.t0) / hdr.dt) < last)
+  {
+    last = (it->t2 - hdr.t0) / hdr.dt;
+  }
+  if (first > last)
+  {
+    return 0;
+  }
+
+  interleaved = (uint8_t)(md->interleaved_mode == 1U);
+  to_hpa = ilps22qs_proc_conv(md->fs);
+  for (i = (uint32_t)first; i <= (uint32_t)last; i++)
+  {
+    ilps22qs_proc_decode(&blk[ILPS22QS_LOG_HDR_SIZE + (3U * i)], interleaved,
+                         to_hpa, &data[i - (uint32_t)first]);
+  }
+  *t0 = hdr.t0 + (first * hdr.dt);
+  *num = (uint16_t)(last - first + 1U);
+
+  return 0;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup     Compression
+  * @brief        This section groups the lossless codec for raw FIFO words.
+  *               Frame layout (bits packed LSB first):
+  *               - count (8 bit), interleaved flag (8 bit)
+  *               - interleaved only: one AH_QVAR tag bit per word
+  *               - per channel: first word (24 bit), mode (1 bit:
+  *                 0 delta, 1 delta-of-delta), width (5 bit), then one
+  *                 zigzag residual of "width" bits per following word.
+  *               In interleaved mode the constant tag bit is dropped from
+  *               the channel values.
+  * @{
+  *
+  */
+
+typedef struct
+{
+  uint8_t *buf;        /* encoder output */
+  const uint8_t *src;  /* decoder input */
+  uint16_t size;
+  uint16_t pos;        /* next byte */
+  uint32_t acc;
+  uint8_t bits;        /* bits pending in acc */
+  uint8_t err;
+} ilps22qs_bitbuf_t;
+
+static void ilps22qs_bit_put(ilps22qs_bitbuf_t *bb, uint32_t val, uint8_t n)
+{
+  uint8_t k;
+
+  /* at most 16 bits per step: acc never holds more than 23 bits */
+  while (n > 0U)
+  {
+    k = (n > 16U) ? 16U : n;
+    bb->acc |= (val & ((1U << k) - 1U)) << bb->bits;
+    bb->bits = (uint8_t)(bb->bits + k);
+    val >>= k;
+    n = (uint8_t)(n - k);
+
+    while (bb->bits >= 8U)
+    {
+      if (bb->pos < bb->size)
+      {
+        bb->buf[bb->pos] = (uint8_t)(bb->acc & 0xFFU);
+        bb->pos++;
+      }
+      else
+      {
+        bb->err = 1U;
+      }
+      bb->acc >>= 8;
+      bb->bits = (uint8_t)(bb->bits - 8U);
+    }
+  }
+}
+
+static void ilps22qs_bit_flush(ilps22qs_bitbuf_t *bb)
+{
+  if (bb->bits != 0U)
+  {
+    ilps22qs_bit_put(bb, 0U, (uint8_t)(8U - bb->bits));
+  }
+}
+
+static uint32_t ilps22qs_bit_get(ilps22qs_bitbuf_t *bb, uint8_t n)
+{
+  uint32_t val = 0U;
+  uint8_t k, shift = 0U;
+
+  while (n > 0U)
+  {
+    k = (n > 16U) ? 16U : n;
+    while (bb->bits < k)
+    {
+      if (bb->pos < bb->size)
+      {
+        bb->acc |= (uint32_t)bb->src[bb->pos] << bb->bits;
+        bb->pos++;
+      }
+      else
+      {
+        bb->err = 1U;
+      }
+      bb->bits = (uint8_t)(bb->bits + 8U);
+    }
+    val |= (bb->acc & ((1U << k) - 1U)) << shift;
+    bb->acc >>= k;
+    bb->bits = (uint8_t)(bb->bits - k);
+    shift = (uint8_t)(shift + k);
+    n = (uint8_t)(n - k);
+  }
+
+  return val;
+}
+
+static uint32_t ilps22qs_zigzag(int32_t v)
+{
+  return (v < 0) ? (((uint32_t)(-(v + 1)) * 2U) + 1U) : ((uint32_t)v * 2U);
+}
+
+static int32_t ilps22qs_unzigzag(uint32_t u)
+{
+  return ((u & 1U) != 0U) ? (-(int32_t)(u / 2U) - 1) : (int32_t)(u / 2U);
+}
+
+static uint8_t ilps22qs_bit_width(uint32_t v)
+{
+  uint8_t n = 0U;
+
+  while (v != 0U)
+  {
+    n++;
+    v >>= 1;
+  }
+
+  return n;
+}
+
+/* channel value: sign-extended 24-bit word, tag bit dropped if interleaved */
+static int32_t ilps22qs_codec_val(const ilps22qs_fifo_data_t *data,
+                                  uint8_t interleaved)
+{
+  int32_t v = data->raw / 256;
+
+  return (interleaved != 0U) ? (v - (v & 1)) / 2 : v;
+}
+
+static void ilps22qs_codec_put_channel(ilps22qs_bitbuf_t *bb,
+                                       const ilps22qs_fifo_data_t *data,
+                                       uint8_t num, uint8_t interleaved,
+                                       uint8_t tag)
+{
+  uint32_t or_d = 0U, or_dd = 0U;
+  int32_t v, prev = 0, d, prev_d = 0;
+  uint8_t i, cnt = 0U, mode, width;
+
+  /* pass 1: residual widths for both predictors */
+  for (i = 0U; i < num; i++)
+  {
+    if ((interleaved == 0U) || ((((uint32_t)data[i].raw >> 8) & 1U) == tag))
+    {
+      v = ilps22qs_codec_val(&data[i], interleaved);
+      if (cnt > 0U)
+      {
+        d = v - prev;
+        or_d |= ilps22qs_zigzag(d);
+        or_dd |= ilps22qs_zigzag((cnt > 1U) ? (d - prev_d) : d);
+        prev_d = d;
+      }
+      else
+      {
+        ilps22qs_bit_put(bb, (uint32_t)data[i].raw >> 8, 24U);
+      }
+      prev = v;
+      cnt++;
+    }
+  }
+
+  if (cnt == 0U)
+  {
+    return;
+  }
+
+  mode = (ilps22qs_bit_width(or_dd) < ilps22qs_bit_width(or_d)) ? 1U : 0U;
+  width = ilps22qs_bit_width((mode != 0U) ? or_dd : or_d);
+  ilps22qs_bit_put(bb, mode, 1U);
+  ilps22qs_bit_put(bb, width, 5U);
+
+  /* pass 2: residuals */
+  cnt = 0U;
+  for (i = 0U; i < num; i++)
+  {
+    if ((interleaved == 0U) || ((((uint32_t)data[i].raw >> 8) & 1U) == tag))
+    {
+      v = ilps22qs_codec_val(&data[i], interleaved);
+      if (cnt > 0U)
+      {
+        d = v - prev;
+        ilps22qs_bit_put(bb, ilps22qs_zigzag(((mode != 0U) && (cnt > 1U)) ?
+                                             (d - prev_d) : d), width);
+        prev_d = d;
+      }
+      prev = v;
+      cnt++;
+    }
+  }
+}
+
+/**
+  * @brief  Compress a batch of FIFO words.
+  *
+  * @param  data        FIFO samples as returned by ilps22qs_fifo_data_get.(ptr)
+  * @param  num         number of samples
+  * @param  interleaved 1 if data comes from interleaved mode
+  * @param  out         compressed frame.(ptr)
+  * @param  out_max     size of out, ILPS22QS_CODEC_SIZE_MAX(num) is enough
+  * @param  out_len     bytes written in out.(ptr)
+  * @retval             0 -> no Error, -1 -> invalid parameters / out full
+  *
+  */
+int32_t ilps22qs_codec_encode(const ilps22qs_fifo_data_t *data, uint8_t num,
+                              uint8_t interleaved, uint8_t *out,
+                              uint16_t out_max, uint16_t *out_len)
+{
+  ilps22qs_bitbuf_t bb;
+  uint8_t i;
+
+  if ((data == NULL) || (out == NULL) || (out_len == NULL))
+  {
+    return -1;
+  }
+
+  (void)memset(&bb, 0, sizeof(ilps22qs_bitbuf_t));
+  bb.buf = out;
+  bb.size = out_max;
+  interleaved &= 0x01U;
+
+  ilps22qs_bit_put(&bb, num, 8U);
+  ilps22qs_bit_put(&bb, interleaved, 8U);
+  if (interleaved != 0U)
+  {
+    for (i = 0U; i < num; i++)
+    {
+      ilps22qs_bit_put(&bb, ((uint32_t)data[i].raw >> 8) & 0x01U, 1U);
+    }
+  }
+  ilps22qs_codec_put_channel(&bb, data, num, interleaved, 0U);
+  if (interleaved != 0U)
+  {
+    ilps22qs_codec_put_channel(&bb, data, num, interleaved, 1U);
+  }
+  ilps22qs_bit_flush(&bb);
+
+  *out_len = bb.pos;
+
+  return (bb.err != 0U) ? -1 : 0;
+}
+
+static void ilps22qs_codec_get_channel(ilps22qs_bitbuf_t *bb,
+                                       ilps22qs_fifo_data_t *data, uint8_t num,
+                                       uint8_t interleaved, uint8_t tag,
+                                       const uint8_t *tags)
+{
+  int32_t v = 0, d = 0;
+  uint8_t i, cnt = 0U, mode = 0U, width = 0U;
+  uint32_t word;
+
+  for (i = 0U; i < num; i++)
+  {
+    if ((interleaved == 0U) ||
+        ((((uint32_t)tags[i / 8U] >> (i % 8U)) & 1U) == tag))
+    {
+      if (cnt == 0U)
+      {
+        word = ilps22qs_bit_get(bb, 24U);
+        v = (int32_t)(word << 8) / 256;
+        if (interleaved != 0U)
+        {
+          v = (v - (v & 1)) / 2;
+        }
+        mode = (uint8_t)ilps22qs_bit_get(bb, 1U);
+        width = (uint8_t)ilps22qs_bit_get(bb, 5U);
+      }
+      else
+      {
+        if ((mode != 0U) && (cnt > 1U))
+        {
+          d += ilps22qs_unzigzag(ilps22qs_bit_get(bb, width));
+        }
+        else
+        {
+          d = ilps22qs_unzigzag(ilps22qs_bit_get(bb, width));
+        }
+        v += d;
+      }
+
+      word = (interleaved != 0U) ? (((uint32_t)v * 2U) | tag) : (uint32_t)v;
+      data[i].raw = (int32_t)((word & 0x00FFFFFFU) << 8);
+      cnt++;
+    }
+  }
+}
+
+/**
+  * @brief  Decompress a frame into FIFO samples.
+  *
+  * @param  in      compressed frame.(ptr)
+  * @param  in_len  bytes available in in
+  * @param  md      the sensor conversion parameters (full scale).(ptr)
+  * @param  data    decoded samples, up to 255 entries.(ptr)
+  * @param  num     number of decoded samples.(ptr)
+  * @param  used    bytes consumed from in.(ptr)
+  * @retval         0 -> no Error, -1 -> invalid parameters / truncated frame
+  *
+  */
+int32_t ilps22qs_codec_decode(const uint8_t *in, uint16_t in_len,
+                              ilps22qs_md_t *md, ilps22qs_fifo_data_t *data,
+                              uint8_t *num, uint16_t *used)
+{
+  uint8_t tags[32] = {0};
+  uint8_t buff[3], interleaved, n, i;
+  ilps22qs_bitbuf_t bb;
+  uint32_t word;
+  ilps22qs_proc_conv_t to_hpa;
+
+  if ((in == NULL) || (md == NULL) || (data == NULL) || (num == NULL) ||
+      (used == NULL))
+  {
+    return -1;
+  }
+
+  (void)memset(&bb, 0, sizeof(ilps22qs_bitbuf_t));
+  bb.src = in;
+  bb.size = in_len;
+
+  n = (uint8_t)ilps22qs_bit_get(&bb, 8U);
+  interleaved = (uint8_t)ilps22qs_bit_get(&bb, 8U) & 0x01U;
+  if (interleaved != 0U)
+  {
+    for (i = 0U; i < n; i++)
+    {
+      tags[i / 8U] |= (uint8_t)(ilps22qs_bit_get(&bb, 1U) << (i % 8U));
+    }
+  }
+  ilps22qs_codec_get_channel(&bb, data, n, interleaved, 0U, tags);
+  if (interleaved != 0U)
+  {
+    ilps22qs_codec_get_channel(&bb, data, n, interleaved, 1U, tags);
+  }
+  if (bb.err != 0U)
+  {
+    return -1;
+  }
+
+  to_hpa = ilps22qs_proc_conv(md->fs);
+  for (i = 0U; i < n; i++)
+  {
+    word = (uint32_t)data[i].raw >> 8;
+    buff[0] = (uint8_t)(word & 0xFFU);
+    buff[1] = (uint8_t)((word >> 8) & 0xFFU);
+    buff[2] = (uint8_t)((word >> 16) & 0xFFU);
+    ilps22qs_proc_decode(buff, interleaved, to_hpa, &data[i]);
+  }
+
+  *num = n;
+  *used = bb.pos;
+
+  return 0;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup     Bus trace
+  * @brief        This section groups the record / replay bus backends.
+  *               Both provide read_reg / write_reg routines to be used in
+  *               a stmdev_ctx_t: the recorder forwards every transaction
+  *               to the real bus and logs it (register, length, payload,
+  *               tick), the replayer acts as the device answering reads
+  *               from the trace and flags any divergence of the driver
+  *               transaction sequence. Records and payload are kept in
+  *               caller buffers, to be saved / loaded by the application.
+  * @{
+  *
+  */
+
+static void ilps22qs_trace_count(ilps22qs_trace_t *trace, uint16_t len)
+{
+  uint32_t now = 0U;
+
+  if (trace->tick != NULL)
+  {
+    now = trace->tick();
+    if (trace->live.transactions != 0U)
+    {
+      trace->live.span += now - trace->last_tick;
+    }
+    trace->last_tick = now;
+  }
+  trace->live.transactions++;
+  trace->live.bytes += len;
+}
+
+static int32_t ilps22qs_trace_log(ilps22qs_trace_t *trace, uint8_t write,
+                                  uint8_t reg, const uint8_t *buf, uint16_t len)
+{
+  ilps22qs_trace_rec_t *r;
+
+  if ((trace->rec_cnt >= trace->rec_max) ||
+      ((trace->payload_max - trace->payload_len) < len))
+  {
+    return -1;
+  }
+
+  r = &trace->rec[trace->rec_cnt];
+  r->write = write;
+  r->reg = reg;
+  r->len = len;
+  r->off = trace->payload_len;
+  r->tick = trace->last_tick;
+  (void)memcpy(&trace->payload[trace->payload_len], buf, len);
+  trace->payload_len += len;
+  trace->rec_cnt++;
+
+  return 0;
+}
+
+/* replay: next record must be the same transaction */
+static const ilps22qs_trace_rec_t *ilps22qs_trace_next(ilps22qs_trace_t *trace,
+                                                       uint8_t write,
+                                                       uint8_t reg,
+                                                       uint16_t len)
+{
+  const ilps22qs_trace_rec_t *r = NULL;
+
+  if ((trace->diverged == 0U) && (trace->pos < trace->rec_cnt))
+  {
+    r = &trace->rec[trace->pos];
+    if ((r->write != write) || (r->reg != reg) || (r->len != len))
+    {
+      r = NULL;
+    }
+  }
+
+  if (r == NULL)
+  {
+    trace->diverged = 1U;
+  }
+  else
+  {
+    trace->pos++;
+  }
+
+  return r;
+}
+
+static int32_t ilps22qs_trace_read(void *handle, uint8_t reg, uint8_t *buf,
+                                   uint16_t len)
+{
+  ilps22qs_trace_t *trace = (ilps22qs_trace_t *)handle;
+  const ilps22qs_trace_rec_t *r;
+  int32_t ret;
+
+  ilps22qs_trace_count(trace, len);
+
+  if (trace->replay != 0U)
+  {
+    r = ilps22qs_trace_next(trace, 0U, reg, len);
+    if (r == NULL)
+    {
+      return -1;
+    }
+    (void)memcpy(buf, &trace->payload[r->off], len);
+    return 0;
+  }
+
+  ret = trace->bus.read_reg(trace->bus.handle, reg, buf, len);
+  if (ret == 0)
+  {
+    ret = ilps22qs_trace_log(trace, 0U, reg, buf, len);
+  }
+
+  return ret;
+}
+
+static int32_t ilps22qs_trace_write(void *handle, uint8_t reg,
+                                    const uint8_t *buf, uint16_t len)
+{
+  ilps22qs_trace_t *trace = (ilps22qs_trace_t *)handle;
+  const ilps22qs_trace_rec_t *r;
+  int32_t ret;
+
+  ilps22qs_trace_count(trace, len);
+
+  if (trace->replay != 0U)
+  {
+    r = ilps22qs_trace_next(trace, 1U, reg, len);
+    if ((r == NULL) || (memcmp(buf, &trace->payload[r->off], len) != 0))
+    {
+      trace->diverged = 1U;
+      return -1;
+    }
+    return 0;
+  }
+
+  ret = trace->bus.write_reg(trace->bus.handle, reg, buf, len);
+  if (ret == 0)
+  {
+    ret = ilps22qs_trace_log(trace, 1U, reg, buf, len);
+  }
+
+  return ret;
+}
+
+/* replay runs at full speed: device settling times are not waited */
+static void ilps22qs_trace_delay(uint32_t millisec)
+{
+  (void)millisec;
+}
+
+/**
+  * @brief  Bus recorder initialization.
+  *
+  * @param  trace        trace handler.(ptr)
+  * @param  bus          real bus interface.(ptr)
+  * @param  tick         time source, NULL if not available
+  * @param  rec          record storage.(ptr)
+  * @param  rec_max      record storage entries
+  * @param  payload      payload storage.(ptr)
+  * @param  payload_max  payload storage size in bytes
+  * @param  ctx          interface to pass to the driver APIs.(ptr)
+  * @retval              0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_trace_rec_init(ilps22qs_trace_t *trace, const stmdev_ctx_t *bus,
+                                ilps22qs_tick_ptr tick,
+                                ilps22qs_trace_rec_t *rec, uint32_t rec_max,
+                                uint8_t *payload, uint32_t payload_max,
+                                stmdev_ctx_t *ctx)
+{
+  if ((trace == NULL) || (bus == NULL) || (rec == NULL) ||
+      (payload == NULL) || (ctx == NULL))
+  {
+    return -1;
+  }
+
+  (void)memset(trace, 0, sizeof(ilps22qs_trace_t));
+  trace->bus = *bus;
+  trace->tick = tick;
+  trace->rec = rec;
+  trace->rec_max = rec_max;
+  trace->payload = payload;
+  trace->payload_max = payload_max;
+
+  ctx->read_reg = ilps22qs_trace_read;
+  ctx->write_reg = ilps22qs_trace_write;
+  ctx->mdelay = bus->mdelay;
+  ctx->handle = trace;
+
+  return 0;
+}
+
+/**
+  * @brief  Bus replayer initialization. ctx->mdelay is set to a no-op, so
+  *         that flows needing a delay routine can be replayed.
+  *
+  * @param  trace        trace handler.(ptr)
+  * @param  tick         time source, NULL if not available
+  * @param  rec          recorded transactions.(ptr)
+  * @param  rec_cnt      number of recorded transactions
+  * @param  payload      recorded payload.(ptr)
+  * @param  payload_len  recorded payload size in bytes
+  * @param  ctx          interface to pass to the driver APIs.(ptr)
+  * @retval              0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_trace_replay_init(ilps22qs_trace_t *trace,
+                                   ilps22qs_tick_ptr tick,
+                                   ilps22qs_trace_rec_t *rec, uint32_t rec_cnt,
+                                   uint8_t *payload, uint32_t payload_len,
+                                   stmdev_ctx_t *ctx)
+{
+  if ((trace == NULL) || (rec == NULL) || (payload == NULL) || (ctx == NULL))
+  {
+    return -1;
+  }
+
+  (void)memset(trace, 0, sizeof(ilps22qs_trace_t));
+  trace->tick = tick;
+  trace->rec = rec;
+  trace->rec_max = rec_cnt;
+  trace->rec_cnt = rec_cnt;
+  trace->payload = payload;
+  trace->payload_max = payload_len;
+  trace->payload_len = payload_len;
+  trace->replay = 1U;
+
+  ctx->read_reg = ilps22qs_trace_read;
+  ctx->write_reg = ilps22qs_trace_write;
+  ctx->mdelay = ilps22qs_trace_delay;
+  ctx->handle = trace;
+
+  return 0;
+}
+
+/**
+  * @brief  Bus cost of a recorded trace, to be compared with trace->live
+  *         after a replay.
+  *
+  * @param  rec    recorded transactions.(ptr)
+  * @param  cnt    number of recorded transactions
+  * @param  stats  transactions, bytes and span in ticks.(ptr)
+  * @retval        0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_trace_stats_get(const ilps22qs_trace_rec_t *rec, uint32_t cnt,
+                                 ilps22qs_trace_stats_t *stats)
+{
+  uint32_t i;
+
+  if ((rec == NULL) || (stats == NULL))
+  {
+    return -1;
+  }
+
+  (void)memset(stats, 0, sizeof(ilps22qs_trace_stats_t));
+  for (i = 0U; i < cnt; i++)
+  {
+    stats->transactions++;
+    stats->bytes += rec[i].len;
+    if (i > 0U)
+    {
+      stats->span += rec[i].tick - rec[i - 1U].tick;
+    }
+  }
+
+  return 0;
+}
+
+/**
+  * @}
+  *
+  */
+
+#if (ILPS22QS_INT_EN != 0) && (ILPS22QS_REF_EN != 0)
+/**
+  * @defgroup     Wake on change
+  * @brief        This section groups the functions keeping the pressure
+  *               threshold event armed around the last reported value, so
+  *               that pressure is read and reported only when it leaves a
+  *               band. The reference is applied to the event only
+  *               (AUTOREFP), the output registers keep the absolute value.
+  *               ILPS22QS has no interrupt pin: the latched event is only
+  *               visible in INT_SOURCE, so the host has to poll
+  *               ilps22qs_woc_event() and cannot sleep until an event.
+  *               Each poll without event costs one 1-byte register read
+  *               (I2C: about 4 bytes on the bus); the REF_P and data
+  *               reads and the re-arm are added only when the event is
+  *               set.
+  * @{
+  *
+  */
+
+/* hPa to THS_P / REF_P units: hPa * 16 @1260hPa, hPa * 8 @4060hPa */
+static uint16_t ilps22qs_hpa_to_ths(ilps22qs_fs_t fs, float_t hpa)
+{
+  float_t ths;
+
+  ths = hpa * ((fs == ILPS22QS_4060hPa) ? 8.0f : 16.0f) + 0.5f;
+  if (ths < 1.0f)
+  {
+    ths = 1.0f;
+  }
+  if (ths > 32767.0f)
+  {
+    ths = 32767.0f;
+  }
+
+  return (uint16_t)ths;
+}
+
+/* latched threshold event; reading INT_SOURCE clears it */
+static int32_t ilps22qs_woc_poll(const stmdev_ctx_t *ctx, uint8_t *ia)
+{
+  ilps22qs_int_source_t int_source;
+  int32_t ret;
+
+  ret = ilps22qs_read_reg(ctx, ILPS22QS_INT_SOURCE, (uint8_t *)&int_source, 1);
+  *ia = (ret == 0) ? int_source.ia : 0U;
+
+  return ret;
+}
+
+/* reference captured by AUTOREFP, REF_P is in THS_P units */
+static int32_t ilps22qs_woc_ref_get(const stmdev_ctx_t *ctx, ilps22qs_fs_t fs,
+                                    float_t *hpa)
+{
+  uint8_t buff[2];
+  int32_t ret;
+
+  ret = ilps22qs_read_reg(ctx, ILPS22QS_REF_P_L, buff, 2);
+  if (ret == 0)
+  {
+    *hpa = (float_t)(((uint32_t)buff[1] * 256U) + (uint32_t)buff[0]) /
+           ((fs == ILPS22QS_4060hPa) ? 8.0f : 16.0f);
+  }
+
+  return ret;
+}
+
+/* capture a new reference on the next sample */
+static int32_t ilps22qs_woc_rearm(const stmdev_ctx_t *ctx)
+{
+  ilps22qs_ref_md_t ref;
+  int32_t ret;
+
+  ref.apply_ref = ILPS22QS_RST_REFS;
+  ref.get_ref = 0;
+  ret = ilps22qs_reference_mode_set(ctx, &ref);
+  if (ret == 0)
+  {
+    ref.apply_ref = ILPS22QS_ONLY_INTERRUPT;
+    ret = ilps22qs_reference_mode_set(ctx, &ref);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Start wake on change: the latched threshold event is set in
+  *         INT_SOURCE when pressure moves more than band_hpa from the
+  *         reference.
+  *
+  * @param  ctx       communication interface handler.(ptr)
+  * @param  md        the sensor conversion parameters.(ptr)
+  * @param  band_hpa  half width of the quiet band in hPa
+  * @param  hyst_hpa  hysteresis in hPa, 0 <= hyst_hpa < band_hpa
+  * @param  woc       wake on change handler.(ptr)
+  * @retval           interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps22qs_woc_start(const stmdev_ctx_t *ctx, ilps22qs_md_t *md,
+                           float_t band_hpa, float_t hyst_hpa,
+                           ilps22qs_woc_t *woc)
+{
+  ilps22qs_int_th_md_t th;
+  ilps22qs_int_mode_t int_mode;
+  ilps22qs_data_t data;
+  int32_t ret;
+
+  if ((md == NULL) || (woc == NULL) || (band_hpa <= 0.0f) ||
+      (hyst_hpa < 0.0f) || (hyst_hpa >= band_hpa))
+  {
+    return -1;
+  }
+
+  (void)memset(woc, 0, sizeof(ilps22qs_woc_t));
+  woc->band_hpa = band_hpa;
+  woc->hyst_hpa = hyst_hpa;
+
+  ret = ilps22qs_data_get(ctx, md, &data);
+  if (ret != 0)
+  {
+    return ret;
+  }
+  woc->ref_hpa = data.pressure.hpa;
+
+  int_mode.int_latched = PROPERTY_ENABLE;
+  ret = ilps22qs_interrupt_mode_set(ctx, &int_mode);
+
+  if (ret == 0)
+  {
+    th.threshold = ilps22qs_hpa_to_ths(md->fs, band_hpa);
+    th.over_th = PROPERTY_ENABLE;
+    th.under_th = PROPERTY_ENABLE;
+    ret = ilps22qs_int_on_threshold_mode_set(ctx, &th);
+  }
+
+  if (ret == 0)
+  {
+    ret = ilps22qs_woc_rearm(ctx);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Wake on change polling, to be called periodically (i.e. at the
+  *         reporting latency required by the application, no faster than
+  *         the ODR). Returns at once when no event is latched; otherwise
+  *         clears the latched event, reads back the reference the event
+  *         was raised against (REF_P) and, if the change is confirmed
+  *         (at least band - hysteresis), re-arms the reference on the
+  *         next sample. Shorter excursions are counted as spurious and
+  *         leave the reference unchanged.
+  *
+  * @param  ctx      communication interface handler.(ptr)
+  * @param  md       the sensor conversion parameters.(ptr)
+  * @param  woc      wake on change handler.(ptr)
+  * @param  hpa      current pressure in hPa.(ptr)
+  * @param  changed  1 if a pressure change is reported.(ptr)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps22qs_woc_event(const stmdev_ctx_t *ctx, ilps22qs_md_t *md,
+                           ilps22qs_woc_t *woc, float_t *hpa,
+                           uint8_t *changed)
+{
+  ilps22qs_data_t data;
+  int32_t ret;
+  uint8_t ia;
+
+  if ((md == NULL) || (woc == NULL) || (hpa == NULL) || (changed == NULL))
+  {
+    return -1;
+  }
+
+  *changed = 0U;
+
+  ret = ilps22qs_woc_poll(ctx, &ia);
+  if ((ret != 0) || (ia == 0U))
+  {
+    return ret;
+  }
+
+  ret = ilps22qs_woc_ref_get(ctx, md->fs, &woc->ref_hpa);
+  if (ret == 0)
+  {
+    ret = ilps22qs_data_get(ctx, md, &data);
+  }
+  if (ret != 0)
+  {
+    return ret;
+  }
+  *hpa = data.pressure.hpa;
+
+  if (fabsf(*hpa - woc->ref_hpa) >= (woc->band_hpa - woc->hyst_hpa))
+  {
+    woc->ref_hpa = *hpa;
+    woc->events++;
+    *changed = 1U;
+    ret = ilps22qs_woc_rearm(ctx);
+  }
+  else
+  {
+    woc->spurious++;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Stop wake on change: threshold interrupt and reference off.
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps22qs_woc_stop(const stmdev_ctx_t *ctx)
+{
+  ilps22qs_int_th_md_t th;
+  ilps22qs_ref_md_t ref;
+  int32_t ret;
+
+  th.threshold = 0;
+  th.over_th = PROPERTY_DISABLE;
+  th.under_th = PROPERTY_DISABLE;
+  ret = ilps22qs_int_on_threshold_mode_set(ctx, &th);
+
+  if (ret == 0)
+  {
+    ref.apply_ref = ILPS22QS_RST_REFS;
+    ref.get_ref = 0;
+    ret = ilps22qs_reference_mode_set(ctx, &ref);
+  }
+
+  if (ret == 0)
+  {
+    ref.apply_ref = ILPS22QS_OUT_AND_INTERRUPT;
+    ret = ilps22qs_reference_mode_set(ctx, &ref);
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+#endif /* ILPS22QS_INT_EN && ILPS22QS_REF_EN */
+
+#if (ILPS22QS_FIFO_EN != 0) && (ILPS22QS_INT_EN != 0) && (ILPS22QS_REF_EN != 0)
+/**
+  * @defgroup     Event capture
+  * @brief        This section groups the functions capturing pressure
+  *               transients: the FIFO streams continuously and keeps the
+  *               last 128 samples in hardware; when the threshold event is
+  *               set, the host locates the triggering sample (the first
+  *               one out of the band) in the FIFO history and reads the
+  *               post-trigger samples as they are acquired, so pre and
+  *               post samples are contiguous.
+  *               The FIFO trigger modes are not used: they switch to FIFO
+  *               mode when the stream is already full, so no post-trigger
+  *               sample could be stored.
+  *               As for wake on change, the event can only be polled in
+  *               INT_SOURCE (one 1-byte read per poll without event); the
+  *               history is kept if the poll comes within 128 - pre
+  *               samples of the event.
+  * @{
+  *
+  */
+
+#define ILPS22QS_CAPT_CHUNK              16U
+
+/* reverse data[a .. b - 1] */
+static void ilps22qs_capt_reverse(ilps22qs_fifo_data_t *data, uint8_t a,
+                                  uint8_t b)
+{
+  ilps22qs_fifo_data_t tmp;
+
+  while (((uint16_t)a + 1U) < b)
+  {
+    b--;
+    tmp = data[a];
+    data[a] = data[b];
+    data[b] = tmp;
+    a++;
+  }
+}
+
+/**
+  * @brief  Arm the event capture.
+  *
+  * @param  ctx       communication interface handler.(ptr)
+  * @param  md        the sensor conversion parameters (not one-shot).(ptr)
+  * @param  band_hpa  trigger threshold, distance from the reference in hPa
+  * @param  pre       samples kept up to the event, 1 .. 127
+  * @param  post      samples read after the event, pre + post <= 255
+  * @param  capt      event capture handler.(ptr)
+  * @retval           interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps22qs_capt_arm(const stmdev_ctx_t *ctx, ilps22qs_md_t *md,
+                          float_t band_hpa, uint8_t pre, uint8_t post,
+                          ilps22qs_capt_t *capt)
+{
+  ilps22qs_fifo_event_t ev = ILPS22QS_FIFO_EV_FULL;
+  int32_t ret;
+
+  if ((ctx == NULL) || (ctx->mdelay == NULL) || (md == NULL) ||
+      (capt == NULL) || (md->odr == ILPS22QS_ONE_SHOT) ||
+      (pre == 0U) || (pre > 127U) || (((uint16_t)pre + post) > 255U))
+  {
+    return -1;
+  }
+
+  (void)memset(capt, 0, sizeof(ilps22qs_capt_t));
+  capt->md = *md;
+  capt->pre = pre;
+  capt->post = post;
+
+  /* whole FIFO depth as history */
+  ret = ilps22qs_fifo_mode_set(ctx, ILPS22QS_BYPASS);
+  ret += ilps22qs_fifo_stop_on_wtm_set(ctx, &ev);
+  if (ret == 0)
+  {
+    ret = ilps22qs_woc_start(ctx, &capt->md, band_hpa, 0.0f, &capt->woc);
+  }
+  if (ret == 0)
+  {
+    ret = ilps22qs_fifo_mode_set(ctx, ILPS22QS_STREAM);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Event capture polling, to be called periodically; returns at
+  *         once when no threshold event is latched.
+  *         Otherwise reads the FIFO history up to the triggering sample
+  *         (the first one out of the band around the REF_P read back),
+  *         keeping the last pre samples, then the post-trigger samples,
+  *         and re-arms the capture around the current pressure.
+  *         data[rec->pre - 1] is the triggering sample, acquired rec->lag
+  *         samples before the poll: sample k is at about
+  *         t + (k + 1 - pre - lag) * period_s.
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  capt  event capture handler.(ptr)
+  * @param  t     timestamp of the poll, in application units
+  * @param  rec   capture record, rec->data holds pre + post samples.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error),
+  *               -1 also when the triggering sample has already left the
+  *               FIFO (event polled too late)
+  *
+  */
+int32_t ilps22qs_capt_event(const stmdev_ctx_t *ctx, ilps22qs_capt_t *capt,
+                            uint32_t t, ilps22qs_capt_rec_t *rec)
+{
+  ilps22qs_fifo_data_t chunk[ILPS22QS_CAPT_CHUNK];
+  uint32_t period_ms, idle_ms;
+  float_t band;
+  uint16_t seen, k;
+  uint8_t level, level0, n, i, found, ring, pos, ia;
+  int32_t ret;
+
+  if ((ctx == NULL) || (ctx->mdelay == NULL) || (capt == NULL) ||
+      (rec == NULL) || (rec->data == NULL))
+  {
+    return -1;
+  }
+
+  rec->t = t;
+  rec->period_s = 1.0f / ilps22qs_odr_to_hz(capt->md.odr);
+  rec->pre = 0U;
+  rec->post = 0U;
+  rec->lag = 0U;
+
+  /* the FIFO keeps streaming */
+  ret = ilps22qs_woc_poll(ctx, &ia);
+  if ((ret != 0) || (ia == 0U))
+  {
+    return ret;
+  }
+
+  ret = ilps22qs_fifo_level_get(ctx, &level0);
+  if (ret == 0)
+  {
+    /* reference the event was raised against */
+    ret = ilps22qs_woc_ref_get(ctx, capt->md.fs, &capt->woc.ref_hpa);
+  }
+
+  /* threshold as programmed, THS_P units */
+  band = (float_t)ilps22qs_hpa_to_ths(capt->md.fs, capt->woc.band_hpa) /
+         ((capt->md.fs == ILPS22QS_4060hPa) ? 8.0f : 16.0f);
+  period_ms = (uint32_t)(1000.0f * rec->period_s);
+  period_ms = (period_ms == 0U) ? 1U : period_ms;
+  idle_ms = 0U;
+  seen = 0U;
+  found = 0U;
+  ring = 0U; /* history: rec->data[0 .. pre - 1] used as a ring */
+  pos = 0U;
+
+  while ((ret == 0) && ((found == 0U) || (rec->post < capt->post)))
+  {
+    if ((found == 0U) && (seen >= level0))
+    {
+      /* triggering sample no longer in the FIFO */
+      ret = -1;
+    }
+    else
+    {
+      ret = ilps22qs_fifo_level_get(ctx, &level);
+    }
+
+    if ((ret == 0) && (level == 0U))
+    {
+      /* no data within 2 s or 10 periods: sensor not running */
+      if ((idle_ms > 2000U) && (idle_ms > (10U * period_ms)))
+      {
+        ret = -1;
+      }
+      ctx->mdelay(period_ms);
+      idle_ms += period_ms;
+    }
+    else if (ret == 0)
+    {
+      idle_ms = 0U;
+      n = (level < ILPS22QS_CAPT_CHUNK) ? level : (uint8_t)ILPS22QS_CAPT_CHUNK;
+      ret = ilps22qs_fifo_data_get(ctx, n, &capt->md, chunk);
+      for (i = 0U; (ret == 0) && (i < n); i++)
+      {
+        if (found == 0U)
+        {
+          rec->data[pos] = chunk[i];
+          pos = ((pos + 1U) < capt->pre) ? (uint8_t)(pos + 1U) : 0U;
+          ring = (ring < capt->pre) ? (uint8_t)(ring + 1U) : ring;
+          /* AH_QVAR samples cannot trigger */
+          if ((ilps22qs_proc_is_press(&chunk[i]) != 0U) &&
+              (fabsf(chunk[i].hpa - capt->woc.ref_hpa) >= band))
+          {
+            found = 1U;
+            rec->lag = (uint8_t)(level0 - 1U - seen);
+            if ((seen == 0U) && (level0 >= 128U))
+            {
+              /* oldest sample of a full FIFO: the trigger may be lost */
+              ret = -1;
+            }
+          }
+        }
+        else if (rec->post < capt->post)
+        {
+          rec->data[capt->pre + rec->post] = chunk[i];
+          rec->post++;
+        }
+        else
+        {
+          /* beyond the capture window */
+        }
+        seen++;
+      }
+    }
+    else
+    {
+      /* interface error */
+    }
+  }
+
+  if ((ret == 0) && (found != 0U))
+  {
+    /* oldest history sample first: rotate the ring left by pos */
+    if (ring == capt->pre)
+    {
+      ilps22qs_capt_reverse(rec->data, 0U, pos);
+      ilps22qs_capt_reverse(rec->data, pos, capt->pre);
+      ilps22qs_capt_reverse(rec->data, 0U, capt->pre);
+    }
+    else if (rec->post != 0U)
+    {
+      /* fewer history samples than pre: close the gap */
+      (void)memmove(&rec->data[ring], &rec->data[capt->pre],
+                    rec->post * sizeof(ilps22qs_fifo_data_t));
+    }
+    else
+    {
+      /* already in place */
+    }
+    rec->pre = ring;
+    /* last pressure sample, the trigger at worst */
+    k = (uint16_t)((uint16_t)rec->pre + rec->post);
+    while (ilps22qs_proc_is_press(&rec->data[k - 1U]) == 0U)
+    {
+      k--;
+    }
+    capt->woc.ref_hpa = rec->data[k - 1U].hpa;
+    capt->captures++;
+  }
+  else
+  {
+    rec->post = 0U;
+  }
+
+  /* re-arm around the current pressure */
+  ret += ilps22qs_fifo_mode_set(ctx, ILPS22QS_BYPASS);
+  ret += ilps22qs_woc_rearm(ctx);
+  ret += ilps22qs_fifo_mode_set(ctx, ILPS22QS_STREAM);
+
+  return ret;
+}
+
+/**
+  * @brief  Disarm the event capture: FIFO in bypass, threshold off.
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps22qs_capt_disarm(const stmdev_ctx_t *ctx)
+{
+  int32_t ret;
+
+  ret = ilps22qs_fifo_mode_set(ctx, ILPS22QS_BYPASS);
+  if (ret == 0)
+  {
+    ret = ilps22qs_woc_stop(ctx);
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+#endif /* ILPS22QS_FIFO_EN && ILPS22QS_INT_EN && ILPS22QS_REF_EN */
+
+#if (ILPS22QS_FIFO_EN != 0) && (ILPS22QS_REF_EN != 0)
+/**
+  * @defgroup     Offset calibration
+  * @brief        This section groups the functions computing the one-point
+  *               calibration (OPC) offset from one FIFO fill taken against
+  *               a reference pressure. RPDS is in hPa * 16 (@1260hPa) or
+  *               hPa * 8 (@4060hPa) and is subtracted from the output.
+  * @{
+  *
+  */
+
+#define ILPS22QS_OPC_CAL_REJECT  3.0f    /* outlier limit in robust sigmas */
+
+static void ilps22qs_sort_hpa(ilps22qs_fifo_data_t *data, uint8_t num)
+{
+  float_t v;
+  uint8_t i, j;
+
+  for (i = 1U; i < num; i++)
+  {
+    v = data[i].hpa;
+    j = i;
+    while ((j > 0U) && (data[j - 1U].hpa > v))
+    {
+      data[j].hpa = data[j - 1U].hpa;
+      j--;
+    }
+    data[j].hpa = v;
+  }
+}
+
+/**
+  * @brief  One-point calibration: the FIFO is filled once at 10 Hz with
+  *         512 averages, the offset to the reference is the mean of the
+  *         samples within 3 robust sigmas (1.4826 * MAD) of the median.
+  *         The new OPC is written, read back and verified, then the
+  *         sensor is set back to md and the FIFO mode, watermark and
+  *         stop_on_wtm are restored (the FIFO content is discarded).
+  *
+  * @param  ctx      communication interface handler.(ptr)
+  * @param  md       the sensor conversion parameters to restore.(ptr)
+  * @param  ref_hpa  reference pressure in hPa
+  * @param  buf      work buffer of num samples.(ptr)
+  * @param  num      samples to collect, 8 .. 127
+  * @param  cal      calibration result.(ptr)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps22qs_opc_calibrate(const stmdev_ctx_t *ctx, ilps22qs_md_t *md,
+                               float_t ref_hpa, ilps22qs_fifo_data_t *buf,
+                               uint8_t num, ilps22qs_opc_cal_t *cal)
+{
+  ilps22qs_fifo_event_t ev = ILPS22QS_FIFO_EV_WTM, ev_old;
+  ilps22qs_operation_t fifo_old;
+  ilps22qs_md_t md_cal;
+  float_t med, mad, lo_d, hi_d, sum, scale, opc;
+  uint32_t idle_ms = 0U;
+  int16_t opc_old = 0, opc_rd = 0;
+  uint8_t level = 0U, wtm_old, i, lo, hi;
+  int32_t ret;
+
+  if ((ctx == NULL) || (ctx->mdelay == NULL) || (md == NULL) ||
+      (buf == NULL) || (cal == NULL) || (num < 8U) || (num > 127U))
+  {
+    return -1;
+  }
+
+  /* FIFO configuration of the caller, restored on exit */
+  ret = ilps22qs_fifo_mode_get(ctx, &fifo_old);
+  ret += ilps22qs_fifo_watermark_get(ctx, &wtm_old);
+  ret += ilps22qs_fifo_stop_on_wtm_get(ctx, &ev_old);
+  if (ret != 0)
+  {
+    return ret;
+  }
+
+  (void)memset(cal, 0, sizeof(ilps22qs_opc_cal_t));
+  md_cal = *md;
+  md_cal.interleaved_mode = 0U;
+  md_cal.odr = ILPS22QS_10Hz;
+  md_cal.avg = ILPS22QS_512_AVG;
+  md_cal.lpf = ILPS22QS_LPF_DISABLE;
+
+  /* FIFO mode stops at the watermark: one fill of num samples */
+  ret += ilps22qs_opc_get(ctx, &opc_old);
+  ret += ilps22qs_fifo_mode_set(ctx, ILPS22QS_BYPASS);
+  ret += ilps22qs_fifo_watermark_set(ctx, num);
+  ret += ilps22qs_fifo_stop_on_wtm_set(ctx, &ev);
+  ret += ilps22qs_mode_set(ctx, &md_cal);
+  ret += ilps22qs_fifo_mode_set(ctx, ILPS22QS_FIFO);
+
+  while ((ret == 0) && (level < num))
+  {
+    ctx->mdelay(100);
+    idle_ms += 100U;
+    ret = ilps22qs_fifo_level_get(ctx, &level);
+    /* twice the expected fill time */
+    if ((ret == 0) && (level < num) && (idle_ms > (200U * (uint32_t)num)))
+    {
+      ret = -1;
+    }
+  }
+
+  if (ret == 0)
+  {
+    ret = ilps22qs_fifo_data_get(ctx, num, &md_cal, buf);
+  }
+
+  if (ret == 0)
+  {
+    /* median and MAD of the deviations from the reference */
+    for (i = 0U; i < num; i++)
+    {
+      buf[i].hpa -= ref_hpa;
+    }
+    ilps22qs_sort_hpa(buf, num);
+    med = buf[num / 2U].hpa;
+
+    /* MAD: walk outward from the median on the sorted deviations */
+    lo = num / 2U;
+    hi = lo + 1U;
+    mad = 0.0f;
+    for (i = 0U; i < (num / 2U); i++)
+    {
+      lo_d = (lo > 0U) ? (med - buf[lo - 1U].hpa) : 3.0e38f;
+      hi_d = (hi < num) ? (buf[hi].hpa - med) : 3.0e38f;
+      if (lo_d <= hi_d)
+      {
+        mad = lo_d;
+        lo--;
+      }
+      else
+      {
+        mad = hi_d;
+        hi++;
+      }
+    }
+
+    sum = 0.0f;
+    for (i = 0U; i < num; i++)
+    {
+      if (fabsf(buf[i].hpa - med) <=
+          (ILPS22QS_OPC_CAL_REJECT * 1.4826f * mad))
+      {
+        sum += buf[i].hpa;
+        cal->used++;
+      }
+      else
+      {
+        cal->rejected++;
+      }
+    }
+    cal->offset_hpa = sum / (float_t)cal->used;
+
+    scale = (md->fs == ILPS22QS_4060hPa) ? 8.0f : 16.0f;
+    opc = (float_t)opc_old + (cal->offset_hpa * scale);
+    opc = (opc > 32767.0f) ? 32767.0f : opc;
+    opc = (opc < -32768.0f) ? -32768.0f : opc;
+    cal->opc = (int16_t)((opc < 0.0f) ? (opc - 0.5f) : (opc + 0.5f));
+
+    ret = ilps22qs_opc_set(ctx, cal->opc);
+    ret += ilps22qs_opc_get(ctx, &opc_rd);
+    if ((ret == 0) && (opc_rd != cal->opc))
+    {
+      ret = -1;
+    }
+  }
+
+  ret += ilps22qs_fifo_mode_set(ctx, ILPS22QS_BYPASS);
+  ret += ilps22qs_mode_set(ctx, md);
+  ret += ilps22qs_fifo_watermark_set(ctx, wtm_old);
+  ret += ilps22qs_fifo_stop_on_wtm_set(ctx, &ev_old);
+  if (fifo_old != ILPS22QS_BYPASS)
+  {
+    ret += ilps22qs_fifo_mode_set(ctx, fifo_old);
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+#endif /* ILPS22QS_FIFO_EN && ILPS22QS_REF_EN */
+
+/**
+  * @defgroup     Temperature compensation
+  * @brief        This section groups the functions applying a per-device
+  *               pressure correction, precomputed on a uniform pressure x
+  *               temperature grid and bilinearly interpolated (clamped at
+  *               the grid edges): hpa += corr(hpa, temperature).
+  *               Temperature is taken once per batch, being much slower
+  *               than pressure, so only the pressure axis is interpolated
+  *               per sample.
+  * @{
+  *
+  */
+
+/* grid cell and fraction of x over n points, clamped to the grid */
+static void ilps22qs_grid_pos(float_t x, uint8_t n, uint8_t *i0, uint8_t *i1,
+                              float_t *f)
+{
+  float_t xi;
+
+  if ((n < 2U) || (x <= 0.0f))
+  {
+    *i0 = 0U;
+    *f = 0.0f;
+  }
+  else if (x >= (float_t)(n - 1U))
+  {
+    *i0 = (uint8_t)(n - 2U);
+    *f = 1.0f;
+  }
+  else
+  {
+    xi = floorf(x);
+    *i0 = (uint8_t)xi;
+    *f = x - xi;
+  }
+  *i1 = (n < 2U) ? *i0 : (uint8_t)(*i0 + 1U);
+}
+
+/**
+  * @brief  Correction at one point of the grid.
+  *
+  * @param  tc     compensation table.(ptr)
+  * @param  hpa    pressure in hPa
+  * @param  deg_c  temperature in degC
+  * @retval        correction in hPa, 0 on invalid table
+  *
+  */
+float_t ilps22qs_tcomp_get(const ilps22qs_tcomp_t *tc, float_t hpa,
+                           float_t deg_c)
+{
+  uint8_t p0, p1, t0, t1;
+  float_t fp, ft, c0, c1;
+
+  if ((tc == NULL) || (tc->corr == NULL) || (tc->np == 0U) ||
+      (tc->nt == 0U) || (tc->p_step <= 0.0f) || (tc->t_step <= 0.0f))
+  {
+    return 0.0f;
+  }
+
+  ilps22qs_grid_pos((hpa - tc->p0) / tc->p_step, tc->np, &p0, &p1, &fp);
+  ilps22qs_grid_pos((deg_c - tc->t0) / tc->t_step, tc->nt, &t0, &t1, &ft);
+
+  c0 = tc->corr[((uint16_t)t0 * tc->np) + p0];
+  c0 += (tc->corr[((uint16_t)t0 * tc->np) + p1] - c0) * fp;
+  c1 = tc->corr[((uint16_t)t1 * tc->np) + p0];
+  c1 += (tc->corr[((uint16_t)t1 * tc->np) + p1] - c1) * fp;
+
+  return c0 + ((c1 - c0) * ft);
+}
+
+/**
+  * @brief  Batch temperature compensation.
+  *
+  * @param  tc     compensation table, np >= 1, nt >= 1, steps > 0.(ptr)
+  * @param  deg_c  temperature of the batch in degC
+  * @param  data   samples to compensate, in place.(ptr)
+  * @param  num    number of samples
+  * @retval        0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_tcomp_apply(const ilps22qs_tcomp_t *tc, float_t deg_c,
+                             ilps22qs_fifo_data_t *data, uint16_t num)
+{
+  const float_t *r0;
+  const float_t *r1;
+  float_t ft, fp, inv_step, c0, c1;
+  uint8_t t0, t1, p0, p1;
+  uint16_t i;
+
+  if ((tc == NULL) || (tc->corr == NULL) || (data == NULL) ||
+      (tc->np == 0U) || (tc->nt == 0U) ||
+      (tc->p_step <= 0.0f) || (tc->t_step <= 0.0f))
+  {
+    return -1;
+  }
+
+  /* temperature axis is fixed for the whole batch */
+  ilps22qs_grid_pos((deg_c - tc->t0) / tc->t_step, tc->nt, &t0, &t1, &ft);
+  r0 = &tc->corr[(uint16_t)t0 * tc->np];
+  r1 = &tc->corr[(uint16_t)t1 * tc->np];
+  inv_step = 1.0f / tc->p_step;
+
+  for (i = 0U; i < num; i++)
+  {
+    if (ilps22qs_proc_is_press(&data[i]) != 0U)
+    {
+      ilps22qs_grid_pos((data[i].hpa - tc->p0) * inv_step, tc->np,
+                        &p0, &p1, &fp);
+      c0 = r0[p0] + ((r0[p1] - r0[p0]) * fp);
+      c1 = r1[p0] + ((r1[p1] - r1[p0]) * fp);
+      data[i].hpa += c0 + ((c1 - c0) * ft);
+    }
+  }
+
+  return 0;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup     AH/QVAR event detector
+  * @brief        This section groups the functions detecting touch and
+  *               presence events on the AH/QVAR channel: the baseline and
+  *               the noise (mean absolute deviation) are tracked while idle,
+  *               an event starts when the deviation exceeds k * noise for
+  *               debounce consecutive samples and ends when it drops below
+  *               half of the threshold. Each sample costs O(1), so the
+  *               event latency is debounce samples.
+  *               The baseline is frozen while active: an event lasting more
+  *               than max_active samples (i.e. a permanent baseline step)
+  *               is ended and the baseline restarts from the current level.
+  * @{
+  *
+  */
+
+/**
+  * @brief  AH/QVAR event detector initialization.
+  *
+  * @param  det       detector handler.(ptr)
+  * @param  alpha     baseline / noise tracking rate, 0 < alpha <= 1
+  * @param  k         threshold in units of noise
+  * @param  min_mv    minimum threshold in mV, > 0 (the noise estimate
+  *                   starts from 0)
+  * @param  debounce  consecutive samples to change state, >= 1
+  * @param  max_active longest event in samples, 0 -> no limit
+  * @retval           0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_qvar_det_init(ilps22qs_qvar_det_t *det, float_t alpha,
+                               float_t k, float_t min_mv, uint8_t debounce,
+                               uint32_t max_active)
+{
+  if ((det == NULL) || (alpha <= 0.0f) || (alpha > 1.0f) || (k <= 0.0f) ||
+      (min_mv <= 0.0f) || (debounce == 0U))
+  {
+    return -1;
+  }
+
+  (void)memset(det, 0, sizeof(ilps22qs_qvar_det_t));
+  det->alpha = alpha;
+  det->k = k;
+  det->min_mv = min_mv;
+  det->debounce = debounce;
+  det->max_active = max_active;
+
+  return 0;
+}
+
+/**
+  * @brief  Process one AH/QVAR sample.
+  *
+  * @param  det   detector handler.(ptr)
+  * @param  mv    AH/QVAR sample in mV
+  * @retval       event detected on this sample
+  *
+  */
+ilps22qs_qvar_ev_t ilps22qs_qvar_det_update(ilps22qs_qvar_det_t *det,
+                                            float_t mv)
+{
+  ilps22qs_qvar_ev_t ev = ILPS22QS_QVAR_EV_NONE;
+  float_t dev, th;
+  uint8_t over;
+
+  if (det->primed == 0U)
+  {
+    det->baseline = mv;
+    det->primed = 1U;
+    return ev;
+  }
+
+  dev = fabsf(mv - det->baseline);
+  th = det->k * det->noise;
+  th = (th < det->min_mv) ? det->min_mv : th;
+
+  /* active state releases at half threshold (hysteresis) */
+  if (det->active == 0U)
+  {
+    over = (dev > th) ? 1U : 0U;
+  }
+  else
+  {
+    over = (dev > (0.5f * th)) ? 1U : 0U;
+  }
+
+  if (over != det->active)
+  {
+    det->cnt++;
+    if (det->cnt >= det->debounce)
+    {
+      det->active = over;
+      det->cnt = 0U;
+      ev = (over != 0U) ? ILPS22QS_QVAR_EV_START : ILPS22QS_QVAR_EV_END;
+    }
+  }
+  else
+  {
+    det->cnt = 0U;
+  }
+
+  if ((det->active != 0U) && (ev == ILPS22QS_QVAR_EV_NONE))
+  {
+    det->active_cnt++;
+    if ((det->max_active != 0U) && (det->active_cnt >= det->max_active))
+    {
+      /* baseline step, not an event: restart from the current level */
+      det->baseline = mv;
+      det->active = 0U;
+      det->cnt = 0U;
+      ev = ILPS22QS_QVAR_EV_END;
+    }
+  }
+  else
+  {
+    det->active_cnt = 0U;
+  }
+
+  /* baseline and noise follow the signal only while idle */
+  if ((det->active == 0U) && (over == 0U))
+  {
+    det->baseline += det->alpha * (mv - det->baseline);
+    det->noise += det->alpha * (dev - det->noise);
+  }
+
+  return ev;
+}
+
+/**
+  * @brief  Process the AH_QVAR samples of an interleaved FIFO batch;
+  *         pressure samples are skipped.
+  *
+  * @param  det     detector handler.(ptr)
+  * @param  data    FIFO samples.(ptr)
+  * @param  num     number of samples
+  * @param  ev      detected events.(ptr)
+  * @param  ev_max  size of ev
+  * @param  ev_num  number of events written in ev.(ptr)
+  * @retval         0 -> no Error, -1 -> invalid parameters or ev full
+  *
+  */
+int32_t ilps22qs_qvar_det_apply(ilps22qs_qvar_det_t *det,
+                                const ilps22qs_fifo_data_t *data,
+                                uint16_t num, ilps22qs_qvar_evt_t *ev,
+                                uint16_t ev_max, uint16_t *ev_num)
+{
+  ilps22qs_qvar_ev_t e;
+  int32_t ret = 0;
+  uint16_t i;
+
+  if ((det == NULL) || (data == NULL) || (ev == NULL) || (ev_num == NULL))
+  {
+    return -1;
+  }
+
+  *ev_num = 0U;
+  for (i = 0U; i < num; i++)
+  {
+    if (ilps22qs_proc_is_press(&data[i]) == 0U)
+    {
+      e = ilps22qs_qvar_det_update(det, ilps22qs_from_lsb_to_mv(data[i].lsb));
+      if (e != ILPS22QS_QVAR_EV_NONE)
+      {
+        if (*ev_num < ev_max)
+        {
+          ev[*ev_num].idx = i;
+          ev[*ev_num].ev = e;
+          (*ev_num)++;
+        }
+        else
+        {
+          ret = -1;
+        }
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup     Interleaved pairing
+  * @brief        This section groups the functions rebuilding time-aligned
+  *               (pressure, AH/QVAR, t) tuples from an interleaved stream,
+  *               at half ODR. The AH/QVAR value is interpolated at the
+  *               pressure sample time from the two AH/QVAR samples around
+  *               it; two consecutive samples with the same tag reveal a
+  *               lost sample (phase slip), which is counted and restarts
+  *               the pairing one slot later.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Pairing stage initialization.
+  *
+  * @param  pair  pairing handler.(ptr)
+  * @param  odr   output data rate of the interleaved stream (not one-shot)
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_pair_init(ilps22qs_pair_t *pair, ilps22qs_odr_t odr)
+{
+  if ((pair == NULL) || (odr == ILPS22QS_ONE_SHOT))
+  {
+    return -1;
+  }
+
+  (void)memset(pair, 0, sizeof(ilps22qs_pair_t));
+  pair->period_s = 1.0f / ilps22qs_odr_to_hz(odr);
+  pair->last_tag = ILPS22QS_PAIR_TAG_NONE;
+
+  return 0;
+}
+
+/**
+  * @brief  Pair a batch of interleaved FIFO samples.
+  *         A pressure sample waiting for its AH/QVAR neighbour is kept
+  *         for the next batch. n is the stream slot of the pressure
+  *         sample from the first sample after init, lost samples
+  *         included; it is kept as an integer (wrapping at 2^32) so that
+  *         the slot time keeps its resolution on long streams: the
+  *         caller converts slot differences, (n - n_ref) * period_s.
+  *
+  * @param  pair     pairing handler.(ptr)
+  * @param  data     interleaved FIFO samples.(ptr)
+  * @param  num      number of samples
+  * @param  out      paired samples.(ptr)
+  * @param  out_max  size of out
+  * @param  out_num  number of tuples written in out.(ptr)
+  * @retval          0 -> no Error, -1 -> invalid parameters or out full
+  *
+  */
+int32_t ilps22qs_pair_apply(ilps22qs_pair_t *pair,
+                            const ilps22qs_fifo_data_t *data, uint16_t num,
+                            ilps22qs_pair_data_t *out, uint16_t out_max,
+                            uint16_t *out_num)
+{
+  int32_t ret = 0;
+  float_t mv;
+  uint16_t i;
+  uint8_t tag;
+
+  if ((pair == NULL) || (data == NULL) || (out == NULL) || (out_num == NULL))
+  {
+    return -1;
+  }
+
+  *out_num = 0U;
+  for (i = 0U; i < num; i++)
+  {
+    tag = (ilps22qs_proc_is_press(&data[i]) == 0U) ? ILPS22QS_PAIR_TAG_QVAR :
+          ILPS22QS_PAIR_TAG_PRESS;
+
+    if (tag == pair->last_tag)
+    {
+      /* one sample of the other kind was lost */
+      pair->slips++;
+      pair->n++;
+      pair->has_p = 0U;
+      pair->has_q = 0U;
+    }
+
+    if (tag == ILPS22QS_PAIR_TAG_PRESS)
+    {
+      pair->p_hpa = data[i].hpa;
+      pair->p_n = pair->n;
+      pair->has_p = 1U;
+    }
+    else
+    {
+      mv = ilps22qs_from_lsb_to_mv(data[i].lsb);
+      if (pair->has_p != 0U)
+      {
+        if (*out_num < out_max)
+        {
+          /* AH/QVAR half a period before and after the pressure sample */
+          out[*out_num].hpa = pair->p_hpa;
+          out[*out_num].mv = (pair->has_q != 0U) ?
+                             (0.5f * (pair->q_mv + mv)) : mv;
+          out[*out_num].n = pair->p_n;
+          (*out_num)++;
+        }
+        else
+        {
+          ret = -1;
+        }
+        pair->has_p = 0U;
+      }
+      pair->q_mv = mv;
+      pair->has_q = 1U;
+    }
+
+    pair->last_tag = tag;
+    pair->n++;
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup     Adaptive ODR
+  * @brief        This section groups the functions switching among a list
+  *               of conversion profiles, ordered from the slowest to the
+  *               fastest, with the signal activity: the rate of change of
+  *               the pressure, smoothed over tau to keep the noise out,
+  *               moves one profile up when above up_th and one profile down
+  *               after staying below down_th for hold_s.
+  *               When two profiles differ only in ODR / AVG, the switch is
+  *               a single CTRL_REG1 read-modify-write under the CTRL lock,
+  *               so the other CTRL_REG1 fields are left as they are.
+  * @{
+  *
+  */
+
+static int32_t ilps22qs_odr_ctl_switch(const stmdev_ctx_t *ctx,
+                                       ilps22qs_odr_ctl_t *ctl, uint8_t next)
+{
+  const ilps22qs_md_t *a = &ctl->prof[ctl->cur];
+  const ilps22qs_md_t *b = &ctl->prof[next];
+  ilps22qs_ctrl_reg1_t ctrl_reg1;
+  int32_t ret;
+
+  if ((a->fs == b->fs) && (a->lpf == b->lpf) &&
+      (a->interleaved_mode == b->interleaved_mode))
+  {
+    ilps22qs_lock(ctx, ILPS22QS_LOCK_CTRL);
+    ret = ilps22qs_read_reg(ctx, ILPS22QS_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
+    if (ret == 0)
+    {
+      ctrl_reg1.odr = (uint8_t)b->odr & 0x0FU;
+      ctrl_reg1.avg = (uint8_t)b->avg & 0x07U;
+      ret = ilps22qs_write_reg(ctx, ILPS22QS_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
+    }
+    ilps22qs_unlock(ctx, ILPS22QS_LOCK_CTRL);
+  }
+  else
+  {
+    ret = ilps22qs_mode_set(ctx, &ctl->prof[next]);
+  }
+
+  if (ret == 0)
+  {
+    ctl->cur = next;
+    ctl->quiet_s = 0.0f;
+    ctl->switches++;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Adaptive ODR controller initialization, applies prof[start].
+  *
+  * @param  ctx      communication interface handler.(ptr)
+  * @param  ctl      controller handler.(ptr)
+  * @param  prof     profiles from the slowest to the fastest (no one-shot).(ptr)
+  * @param  num      number of profiles
+  * @param  start    initial profile
+  * @param  tau_s    smoothing time constant in s
+  * @param  up_th    rate of change to go up, hPa/s
+  * @param  down_th  rate of change to go down, hPa/s (< up_th)
+  * @param  hold_s   time below down_th before going down, s (>= 0)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps22qs_odr_ctl_init(const stmdev_ctx_t *ctx, ilps22qs_odr_ctl_t *ctl,
+                              ilps22qs_md_t *prof, uint8_t num, uint8_t start,
+                              float_t tau_s, float_t up_th, float_t down_th,
+                              float_t hold_s)
+{
+  uint8_t i;
+
+  if ((ctl == NULL) || (prof == NULL) || (num == 0U) || (start >= num) ||
+      (tau_s <= 0.0f) || (hold_s < 0.0f) || (down_th < 0.0f) ||
+      (up_th <= down_th))
+  {
+    return -1;
+  }
+  for (i = 0U; i < num; i++)
+  {
+    if (prof[i].odr == ILPS22QS_ONE_SHOT)
+    {
+      return -1;
+    }
+  }
+
+  (void)memset(ctl, 0, sizeof(ilps22qs_odr_ctl_t));
+  ctl->prof = prof;
+  ctl->num = num;
+  ctl->cur = start;
+  ctl->tau_s = tau_s;
+  ctl->up_th = up_th;
+  ctl->down_th = down_th;
+  ctl->hold_s = hold_s;
+
+  return ilps22qs_mode_set(ctx, &prof[start]);
+}
+
+/**
+  * @brief  Feed a batch decoded with the current profile and switch
+  *         profile if needed. Samples read after a switch are at the
+  *         new rate, except the ones already queued in the FIFO;
+  *         ctl->switch_at is the number of samples processed before the
+  *         last switch.
+  *
+  * @param  ctx       communication interface handler.(ptr)
+  * @param  ctl       controller handler.(ptr)
+  * @param  data      samples of the current profile.(ptr)
+  * @param  num       number of samples
+  * @param  switched  1 if the profile changed, see ctl->cur.(ptr)
+  * @retval           interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps22qs_odr_ctl_apply(const stmdev_ctx_t *ctx, ilps22qs_odr_ctl_t *ctl,
+                               const ilps22qs_fifo_data_t *data, uint16_t num,
+                               uint8_t *switched)
+{
+  float_t dt, a, s_prev, r;
+  int32_t ret = 0;
+  uint16_t i;
+
+  if ((ctl == NULL) || (data == NULL) || (switched == NULL))
+  {
+    return -1;
+  }
+
+  *switched = 0U;
+  dt = 1.0f / ilps22qs_press_rate_hz(&ctl->prof[ctl->cur]);
+  a = dt / ctl->tau_s;
+  a = (a > 1.0f) ? 1.0f : a;
+
+  for (i = 0U; i < num; i++)
+  {
+    if (ilps22qs_proc_is_press(&data[i]) != 0U)
+    {
+      if (ctl->primed == 0U)
+      {
+        ctl->smooth = data[i].hpa;
+        ctl->primed = 1U;
+      }
+      else
+      {
+        s_prev = ctl->smooth;
+        ctl->smooth += a * (data[i].hpa - ctl->smooth);
+        ctl->rate += a * (((ctl->smooth - s_prev) / dt) - ctl->rate);
+      }
+      ctl->quiet_s = (fabsf(ctl->rate) < ctl->down_th) ?
+                     (ctl->quiet_s + dt) : 0.0f;
+    }
+    ctl->seq++;
+  }
+
+  r = fabsf(ctl->rate);
+  if ((r > ctl->up_th) && ((ctl->cur + 1U) < ctl->num))
+  {
+    ret = ilps22qs_odr_ctl_switch(ctx, ctl, (uint8_t)(ctl->cur + 1U));
+    *switched = 1U;
+  }
+  else if ((ctl->quiet_s >= ctl->hold_s) && (ctl->cur > 0U))
+  {
+    ret = ilps22qs_odr_ctl_switch(ctx, ctl, (uint8_t)(ctl->cur - 1U));
+    *switched = 1U;
+  }
+  else
+  {
+    /* keep the current profile */
+  }
+
+  if (*switched != 0U)
+  {
+    ctl->switch_at = ctl->seq;
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup     Trend store
+  * @brief        This section groups the functions keeping pressure
+  *               rollups (min / max / mean) at 1 s, 1 min and 1 h
+  *               resolution in fixed size rings, see ILPS22QS_TREND_*_N.
+  *               Each sample updates the open 1 s bucket; a bucket is
+  *               stored in its ring and merged into the next level when
+  *               time moves past it. Completed buckets are addressed by
+  *               age, so every query is O(1).
+  * @{
+  *
+  */
+
+static const uint32_t ilps22qs_trend_scale[ILPS22QS_TREND_LEVELS] =
+{
+  1U, 60U, 3600U
+};
+
+static const uint16_t ilps22qs_trend_len[ILPS22QS_TREND_LEVELS] =
+{
+  ILPS22QS_TREND_SEC_N, ILPS22QS_TREND_MIN_N, ILPS22QS_TREND_HOUR_N
+};
+
+static ilps22qs_trend_bkt_t *ilps22qs_trend_ring(ilps22qs_trend_t *tr,
+                                                 uint8_t level)
+{
+  ilps22qs_trend_bkt_t *ring;
+
+  switch (level)
+  {
+    case ILPS22QS_TREND_SEC:
+      ring = tr->sec;
+      break;
+    case ILPS22QS_TREND_MIN:
+      ring = tr->min;
+      break;
+    default:
+      ring = tr->hour;
+      break;
+  }
+
+  return ring;
+}
+
+static void ilps22qs_trend_merge(ilps22qs_trend_bkt_t *dst,
+                                 const ilps22qs_trend_bkt_t *src,
+                                 uint32_t idx)
+{
+  if (dst->cnt == 0U)
+  {
+    *dst = *src;
+    dst->idx = idx;
+  }
+  else
+  {
+    dst->sum_dev += src->sum_dev +
+                    ((src->first - dst->first) * (float_t)src->cnt);
+    dst->min = (src->min < dst->min) ? src->min : dst->min;
+    dst->max = (src->max > dst->max) ? src->max : dst->max;
+    dst->cnt += src->cnt;
+  }
+}
+
+/**
+  * @brief  Trend store initialization.
+  *
+  * @param  tr    trend store.(ptr)
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_trend_init(ilps22qs_trend_t *tr)
+{
+  if (tr == NULL)
+  {
+    return -1;
+  }
+
+  (void)memset(tr, 0, sizeof(ilps22qs_trend_t));
+
+  return 0;
+}
+
+/**
+  * @brief  Add one pressure sample.
+  *
+  * @param  tr    trend store.(ptr)
+  * @param  t_s   sample time in s, not decreasing
+  * @param  hpa   pressure in hPa
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_trend_add(ilps22qs_trend_t *tr, uint32_t t_s, float_t hpa)
+{
+  ilps22qs_trend_bkt_t *cur;
+  ilps22qs_trend_bkt_t *ring;
+  uint8_t l;
+
+  if ((tr == NULL) || ((tr->cur[0].cnt != 0U) && (t_s < tr->cur[0].idx)))
+  {
+    return -1;
+  }
+
+  /* close the buckets time has moved past, from the finest level up */
+  for (l = 0U; l < ILPS22QS_TREND_LEVELS; l++)
+  {
+    cur = &tr->cur[l];
+    if ((cur->cnt == 0U) || (cur->idx == (t_s / ilps22qs_trend_scale[l])))
+    {
+      break;
+    }
+    ring = ilps22qs_trend_ring(tr, l);
+    ring[cur->idx % ilps22qs_trend_len[l]] = *cur;
+    if ((l + 1U) < ILPS22QS_TREND_LEVELS)
+    {
+      ilps22qs_trend_merge(&tr->cur[l + 1U], cur,
+                           cur->idx / (ilps22qs_trend_scale[l + 1U] /
+                                       ilps22qs_trend_scale[l]));
+    }
+    cur->cnt = 0U;
+  }
+
+  cur = &tr->cur[0];
+  if (cur->cnt == 0U)
+  {
+    cur->idx = t_s;
+    cur->first = hpa;
+    cur->min = hpa;
+    cur->max = hpa;
+    cur->sum_dev = 0.0f;
+  }
+  else
+  {
+    cur->sum_dev += hpa - cur->first;
+    cur->min = (hpa < cur->min) ? hpa : cur->min;
+    cur->max = (hpa > cur->max) ? hpa : cur->max;
+  }
+  cur->cnt++;
+
+  return 0;
+}
+
+/**
+  * @brief  Add a batch of samples.
+  *
+  * @param  tr    trend store.(ptr)
+  * @param  t0_s  time of the first sample in s
+  * @param  dt_s  sample period in s
+  * @param  data  samples.(ptr)
+  * @param  num   number of samples
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_trend_apply(ilps22qs_trend_t *tr, uint32_t t0_s, float_t dt_s,
+                             const ilps22qs_fifo_data_t *data, uint16_t num)
+{
+  int32_t ret = 0;
+  uint16_t i;
+
+  if ((tr == NULL) || (data == NULL) || (dt_s < 0.0f))
+  {
+    return -1;
+  }
+
+  for (i = 0U; (i < num) && (ret == 0); i++)
+  {
+    if (ilps22qs_proc_is_press(&data[i]) != 0U)
+    {
+      ret = ilps22qs_trend_add(tr, t0_s + (uint32_t)((float_t)i * dt_s),
+                               data[i].hpa);
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Completed bucket by age: ago = 0 is the last completed bucket
+  *         of the level before the current time.
+  *
+  * @param  tr     trend store.(ptr)
+  * @param  level  ILPS22QS_TREND_SEC, _MIN or _HOUR
+  * @param  ago    age in buckets of the level, < ring length
+  * @param  val    bucket min / max / mean.(ptr)
+  * @retval        0 -> no Error, -1 -> invalid parameters or no data
+  *
+  */
+int32_t ilps22qs_trend_get(ilps22qs_trend_t *tr, uint8_t level,
+                           uint16_t ago, ilps22qs_trend_val_t *val)
+{
+  const ilps22qs_trend_bkt_t *b;
+  uint32_t now, idx;
+
+  if ((tr == NULL) || (val == NULL) || (level >= ILPS22QS_TREND_LEVELS) ||
+      (tr->cur[0].cnt == 0U) || (ago >= ilps22qs_trend_len[level]))
+  {
+    return -1;
+  }
+
+  now = tr->cur[0].idx / ilps22qs_trend_scale[level];
+  if (now <= ago)
+  {
+    return -1;
+  }
+  idx = now - 1U - ago;
+
+  b = &ilps22qs_trend_ring(tr, level)[idx % ilps22qs_trend_len[level]];
+  if ((b->cnt == 0U) || (b->idx != idx))
+  {
+    /* no samples in that period */
+    return -1;
+  }
+
+  val->min = b->min;
+  val->max = b->max;
+  val->mean = b->first + (b->sum_dev / (float_t)b->cnt);
+  val->cnt = b->cnt;
+
+  return 0;
+}
+
+/**
+  * @brief  Tendency: mean of the last completed bucket minus the mean of
+  *         the bucket n periods earlier (i.e. level HOUR, n = 3 gives the
+  *         3-hour barometric tendency).
+  *
+  * @param  tr     trend store.(ptr)
+  * @param  level  ILPS22QS_TREND_SEC, _MIN or _HOUR
+  * @param  n      distance in buckets of the level
+  * @param  dp     tendency in hPa.(ptr)
+  * @retval        0 -> no Error, -1 -> invalid parameters or no data
+  *
+  */
+int32_t ilps22qs_trend_delta(ilps22qs_trend_t *tr, uint8_t level, uint16_t n,
+                             float_t *dp)
+{
+  ilps22qs_trend_val_t a, b;
+  int32_t ret;
+
+  if (dp == NULL)
+  {
+    return -1;
+  }
+
+  ret = ilps22qs_trend_get(tr, level, 0U, &a);
+  if (ret == 0)
+  {
+    ret = ilps22qs_trend_get(tr, level, n, &b);
+  }
+  if (ret == 0)
+  {
+    *dp = a.mean - b.mean;
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup     Differential pressure
+  * @brief        This section groups the functions computing the pressure
+  *               difference between two sensors: each FIFO stream is
+  *               queued with its reconstructed sample times, both are
+  *               linearly interpolated on a common time grid and the
+  *               difference a - b, less a zero offset, is output.
+  *               Two consecutive samples more than
+  *               ILPS22QS_DIFF_GAP_K sample periods apart are a gap (lost
+  *               samples): no output is interpolated across it.
+  *               Sample times are kept as s from a reference moved
+  *               forward every ILPS22QS_DIFF_REBASE_S to keep the float
+  *               resolution. One handler per pair.
+  * @{
+  *
+  */
+
+#define ILPS22QS_DIFF_REBASE_S   60.0f
+#define ILPS22QS_DIFF_GAP_K      1.5f
+
+static void ilps22qs_diff_pop(ilps22qs_diff_ch_t *ch)
+{
+  ch->head = (uint16_t)((ch->head + 1U) % ILPS22QS_DIFF_BUF_N);
+  ch->cnt--;
+}
+
+static float_t ilps22qs_diff_time(const ilps22qs_diff_ch_t *ch, uint16_t k)
+{
+  return ch->t[(ch->head + k) % ILPS22QS_DIFF_BUF_N];
+}
+
+static float_t ilps22qs_diff_hpa(const ilps22qs_diff_ch_t *ch, uint16_t k)
+{
+  return ch->hpa[(ch->head + k) % ILPS22QS_DIFF_BUF_N];
+}
+
+/**
+  * @brief  Differential pair initialization.
+  *
+  * @param  pair  differential pair handler.(ptr)
+  * @param  dt_s  output grid period in s
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_diff_init(ilps22qs_diff_t *pair, float_t dt_s)
+{
+  if ((pair == NULL) || (dt_s <= 0.0f))
+  {
+    return -1;
+  }
+
+  (void)memset(pair, 0, sizeof(ilps22qs_diff_t));
+  pair->dt_s = dt_s;
+
+  return 0;
+}
+
+/**
+  * @brief  Queue a FIFO batch of one sensor.
+  *
+  * @param  pair   differential pair handler.(ptr)
+  * @param  ch     sensor: 0 -> a, 1 -> b
+  * @param  t0_ms  time of the first sample in ms
+  * @param  dt_s   sample period in s, > 0
+  * @param  data   samples.(ptr)
+  * @param  num    number of samples
+  * @retval        0 -> no Error, -1 -> invalid parameters, queue full or
+  *                first sample not after the last queued one (nothing is
+  *                queued)
+  *
+  */
+int32_t ilps22qs_diff_push(ilps22qs_diff_t *pair, uint8_t ch, uint32_t t0_ms,
+                           float_t dt_s, const ilps22qs_fifo_data_t *data,
+                           uint16_t num)
+{
+  ilps22qs_diff_ch_t *c;
+  float_t t0;
+  uint16_t i, k, n, first;
+
+  if ((pair == NULL) || (ch > 1U) || (data == NULL) || (dt_s <= 0.0f))
+  {
+    return -1;
+  }
+
+  c = &pair->ch[ch];
+  n = 0U;
+  first = num;
+  for (i = 0U; i < num; i++)
+  {
+    if (ilps22qs_proc_is_press(&data[i]) != 0U)
+    {
+      first = (n == 0U) ? i : first;
+      n++;
+    }
+  }
+  if (n > (ILPS22QS_DIFF_BUF_N - c->cnt))
+  {
+    return -1;
+  }
+
+  t0 = (pair->has_ref != 0U) ?
+       ((float_t)((int32_t)(t0_ms - pair->t_ref_ms)) / 1000.0f) : 0.0f;
+  if ((n != 0U) && (c->cnt != 0U) &&
+      ((t0 + ((float_t)first * dt_s)) <=
+       ilps22qs_diff_time(c, (uint16_t)(c->cnt - 1U))))
+  {
+    /* times must increase across batches */
+    return -1;
+  }
+
+  if (pair->has_ref == 0U)
+  {
+    pair->t_ref_ms = t0_ms;
+    pair->has_ref = 1U;
+  }
+
+  for (i = 0U; i < num; i++)
+  {
+    if (ilps22qs_proc_is_press(&data[i]) != 0U)
+    {
+      c->dt_s = dt_s;
+      k = (uint16_t)((c->head + c->cnt) % ILPS22QS_DIFF_BUF_N);
+      c->t[k] = t0 + ((float_t)i * dt_s);
+      c->hpa[k] = data[i].hpa;
+      c->cnt++;
+    }
+  }
+
+  return 0;
+}
+
+/**
+  * @brief  Start the zero offset calibration on the next n outputs
+  *         (same pressure applied to both sensors).
+  *
+  * @param  pair  differential pair handler.(ptr)
+  * @param  n     number of outputs to average
+  * @retval       0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_diff_zero(ilps22qs_diff_t *pair, uint16_t n)
+{
+  if ((pair == NULL) || (n == 0U))
+  {
+    return -1;
+  }
+
+  pair->zero_n = n;
+  pair->zero_left = n;
+  pair->zero_sum = 0.0f;
+
+  return 0;
+}
+
+/**
+  * @brief  Differential samples on the grid covered by both sensors.
+  *
+  * @param  pair     differential pair handler.(ptr)
+  * @param  out      differential samples.(ptr)
+  * @param  out_max  size of out
+  * @param  out_num  number of samples written in out.(ptr)
+  * @retval          0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_diff_get(ilps22qs_diff_t *pair, ilps22qs_diff_data_t *out,
+                          uint16_t out_max, uint16_t *out_num)
+{
+  ilps22qs_diff_ch_t *c;
+  float_t v[2], t0, t1, shift, skip;
+  uint8_t ready, j;
+  uint16_t k;
+
+  if ((pair == NULL) || (out == NULL) || (out_num == NULL))
+  {
+    return -1;
+  }
+
+  *out_num = 0U;
+  ready = 1U;
+  while ((ready != 0U) && (*out_num < out_max))
+  {
+    skip = 0.0f;
+    if (pair->started == 0U)
+    {
+      if ((pair->ch[0].cnt == 0U) || (pair->ch[1].cnt == 0U))
+      {
+        break;
+      }
+      t0 = ilps22qs_diff_time(&pair->ch[0], 0U);
+      t1 = ilps22qs_diff_time(&pair->ch[1], 0U);
+      pair->t_next = (t0 > t1) ? t0 : t1;
+      pair->started = 1U;
+    }
+
+    for (j = 0U; j < 2U; j++)
+    {
+      c = &pair->ch[j];
+      while ((c->cnt >= 2U) && (ilps22qs_diff_time(c, 1U) <= pair->t_next))
+      {
+        ilps22qs_diff_pop(c);
+      }
+      if (c->cnt < 2U)
+      {
+        /* wait for the next batch */
+        ready = 0U;
+      }
+      else if (ilps22qs_diff_time(c, 0U) > pair->t_next)
+      {
+        /* gap in the stream: no output at this grid point */
+        ready = (ready != 0U) ? 2U : 0U;
+      }
+      else
+      {
+        t0 = ilps22qs_diff_time(c, 0U);
+        t1 = ilps22qs_diff_time(c, 1U);
+        if (((t1 - t0) > (ILPS22QS_DIFF_GAP_K * c->dt_s)) &&
+            (pair->t_next > t0))
+        {
+          /* lost samples: no output until the stream resumes at t1 */
+          skip = (t1 > skip) ? t1 : skip;
+          ready = (ready != 0U) ? 2U : 0U;
+        }
+        v[j] = ilps22qs_diff_hpa(c, 0U) +
+               ((ilps22qs_diff_hpa(c, 1U) - ilps22qs_diff_hpa(c, 0U)) *
+                ((pair->t_next - t0) / (t1 - t0)));
+      }
+    }
+
+    if (ready == 1U)
+    {
+      if (pair->zero_left > 0U)
+      {
+        pair->zero_sum += v[0] - v[1];
+        pair->zero_left--;
+        if (pair->zero_left == 0U)
+        {
+          pair->offset = pair->zero_sum / (float_t)pair->zero_n;
+        }
+      }
+      out[*out_num].t_ms = pair->t_ref_ms +
+                           (uint32_t)((int32_t)floorf((pair->t_next *
+                                                       1000.0f) + 0.5f));
+      out[*out_num].dp_hpa = (v[0] - v[1]) - pair->offset;
+      (*out_num)++;
+    }
+    if (ready != 0U)
+    {
+      pair->t_next += pair->dt_s;
+      if (pair->t_next < skip)
+      {
+        /* first grid point after the gap */
+        pair->t_next += ceilf((skip - pair->t_next) / pair->dt_s) *
+                        pair->dt_s;
+      }
+      ready = 1U;
+    }
+  }
+
+  /* move the time reference forward */
+  if (pair->t_next > ILPS22QS_DIFF_REBASE_S)
+  {
+    shift = ILPS22QS_DIFF_REBASE_S *
+            floorf(pair->t_next / ILPS22QS_DIFF_REBASE_S);
+    pair->t_ref_ms += (uint32_t)(shift * 1000.0f);
+    pair->t_next -= shift;
+    for (j = 0U; j < 2U; j++)
+    {
+      for (k = 0U; k < ILPS22QS_DIFF_BUF_N; k++)
+      {
+        pair->ch[j].t[k] -= shift;
+      }
+    }
+  }
+
+  return 0;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup     Spectral analysis
+  * @brief        This section groups the functions computing band energies
+  *               of the pressure stream with a Goertzel bank: every hop
+  *               samples, the last win samples (Hann window, mean removed)
+  *               are evaluated on the DFT bins falling in each band.
+  *               The energy of a band is its share of the mean square of
+  *               the windowed signal, in hPa^2 (a sine of amplitude A
+  *               inside the band gives about A^2 / 2). Samples are kept in
+  *               a ring inside the handler, nothing is allocated per
+  *               window; the cost per window is win * (bins + 1) MACs.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Spectral analysis initialization.
+  *
+  * @param  spec   spectral analysis handler.(ptr)
+  * @param  md     operating mode of the stream (not one-shot): in
+  *                interleaved mode the pressure rate is half the ODR.(ptr)
+  * @param  win    window length in pressure samples,
+  *                8 .. ILPS22QS_SPECT_WIN_MAX
+  * @param  hop    pressure samples between windows, 1 .. win
+  * @param  f_lo   lower edge of each band in Hz.(ptr)
+  * @param  f_hi   upper edge of each band in Hz, >= f_lo.(ptr)
+  * @param  bands  number of bands, 1 .. ILPS22QS_SPECT_BANDS_MAX
+  * @retval        0 -> no Error, -1 -> invalid parameters, a band with no
+  *                bin or more than ILPS22QS_SPECT_BINS_MAX bins
+  *
+  */
+int32_t ilps22qs_spect_init(ilps22qs_spect_t *spec, const ilps22qs_md_t *md,
+                            uint16_t win, uint16_t hop, const float_t *f_lo,
+                            const float_t *f_hi, uint8_t bands)
+{
+  float_t fs, k_lo, k_hi;
+  uint16_t k;
+  uint8_t b;
+
+  if ((spec == NULL) || (md == NULL) || (f_lo == NULL) || (f_hi == NULL) ||
+      (md->odr == ILPS22QS_ONE_SHOT) || (win < 8U) ||
+      (win > ILPS22QS_SPECT_WIN_MAX) || (hop == 0U) || (hop > win) ||
+      (bands == 0U) || (bands > ILPS22QS_SPECT_BANDS_MAX))
+  {
+    return -1;
+  }
+
+  (void)memset(spec, 0, sizeof(ilps22qs_spect_t));
+  spec->win = win;
+  spec->hop = hop;
+  spec->bands = bands;
+
+  fs = ilps22qs_press_rate_hz(md);
+
+  /* bins k = 1 .. win / 2 with k * fs / win inside [f_lo, f_hi] */
+  for (b = 0U; b < bands; b++)
+  {
+    if (f_lo[b] > f_hi[b])
+    {
+      return -1;
+    }
+    k_lo = ceilf((f_lo[b] * (float_t)win) / fs);
+    k_hi = floorf((f_hi[b] * (float_t)win) / fs);
+    k_lo = (k_lo < 1.0f) ? 1.0f : k_lo;
+    k_hi = (k_hi > (float_t)(win / 2U)) ? (float_t)(win / 2U) : k_hi;
+    if (k_lo > k_hi)
+    {
+      /* narrower than the bin spacing fs / win or out of range */
+      return -1;
+    }
+    for (k = (uint16_t)k_lo; (float_t)k <= k_hi; k++)
+    {
+      if (spec->bins >= ILPS22QS_SPECT_BINS_MAX)
+      {
+        return -1;
+      }
+      spec->coeff[spec->bins] =
+        2.0f * cosf((6.2831853f * (float_t)k) / (float_t)win);
+      /* DC and Nyquist bins have no mirror image */
+      spec->scale[spec->bins] = ((2U * k) == win) ? 1.0f : 2.0f;
+      spec->band[spec->bins] = b;
+      spec->bins++;
+    }
+  }
+
+  return 0;
+}
+
+/* Goertzel bank over the last win samples of the ring */
+static void ilps22qs_spect_window(ilps22qs_spect_t *spec, float_t *energy)
+{
+  float_t s1[ILPS22QS_SPECT_BINS_MAX];
+  float_t s2[ILPS22QS_SPECT_BINS_MAX];
+  float_t mean, c, s, cd, sd, tmp, w, x, w2, p;
+  uint16_t n, i;
+  uint8_t k;
+
+  (void)memset(s1, 0, sizeof(s1));
+  (void)memset(s2, 0, sizeof(s2));
+  (void)memset(energy, 0, ILPS22QS_SPECT_BANDS_MAX * sizeof(float_t));
+
+  mean = 0.0f;
+  for (n = 0U; n < spec->win; n++)
+  {
+    mean += spec->buf[n];
+  }
+  mean /= (float_t)spec->win;
+
+  /* periodic Hann window, cos(2 pi n / win) by rotation */
+  c = 1.0f;
+  s = 0.0f;
+  cd = cosf(6.2831853f / (float_t)spec->win);
+  sd = sinf(6.2831853f / (float_t)spec->win);
+  w2 = 0.0f;
+  i = spec->pos;
+  for (n = 0U; n < spec->win; n++)
+  {
+    w = 0.5f - (0.5f * c);
+    w2 += w * w;
+    x = w * (spec->buf[i] - mean);
+    for (k = 0U; k < spec->bins; k++)
+    {
+      tmp = x + (spec->coeff[k] * s1[k]) - s2[k];
+      s2[k] = s1[k];
+      s1[k] = tmp;
+    }
+    tmp = (c * cd) - (s * sd);
+    s = (s * cd) + (c * sd);
+    c = tmp;
+    i = (uint16_t)((i + 1U) % spec->win);
+  }
+
+  /* Parseval: mean square = sum over bins of |X|^2 / (win * sum w^2) */
+  for (k = 0U; k < spec->bins; k++)
+  {
+    p = (s1[k] * s1[k]) + (s2[k] * s2[k]) - (spec->coeff[k] * s1[k] * s2[k]);
+    energy[spec->band[k]] += (spec->scale[k] * p) / ((float_t)spec->win * w2);
+  }
+}
+
+/**
+  * @brief  Feed a batch of samples.
+  *         One output is produced every hop samples once win samples
+  *         have been collected.
+  *
+  * @param  spec     spectral analysis handler.(ptr)
+  * @param  data     samples.(ptr)
+  * @param  num      number of samples
+  * @param  out      band energies.(ptr)
+  * @param  out_max  size of out
+  * @param  out_num  number of outputs written in out.(ptr)
+  * @retval          0 -> no Error, -1 -> invalid parameters or out full
+  *
+  */
+int32_t ilps22qs_spect_apply(ilps22qs_spect_t *spec,
+                             const ilps22qs_fifo_data_t *data, uint16_t num,
+                             ilps22qs_spect_data_t *out, uint16_t out_max,
+                             uint16_t *out_num)
+{
+  int32_t ret = 0;
+  uint16_t i;
+
+  if ((spec == NULL) || (data == NULL) || (out == NULL) || (out_num == NULL))
+  {
+    return -1;
+  }
+
+  *out_num = 0U;
+  for (i = 0U; i < num; i++)
+  {
+    if (ilps22qs_proc_is_press(&data[i]) != 0U)
+    {
+      spec->buf[spec->pos] = data[i].hpa;
+      spec->pos = (uint16_t)((spec->pos + 1U) % spec->win);
+      spec->seq++;
+      spec->cnt = (spec->cnt < spec->win) ? (spec->cnt + 1U) : spec->win;
+      spec->since++;
+
+      if ((spec->cnt == spec->win) && (spec->since >= spec->hop))
+      {
+        spec->since = 0U;
+        if (*out_num < out_max)
+        {
+          ilps22qs_spect_window(spec, out[*out_num].energy);
+          out[*out_num].seq = spec->seq;
+          (*out_num)++;
+        }
+        else
+        {
+          ret = -1;
+        }
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+#endif /* ILPS22QS_FLOAT_EN */
+
+/**
+  * @defgroup     Fixed-point temperature compensation
+  * @brief        Integer variant of the temperature compensation for
+  *               targets without FPU: available with ILPS22QS_FLOAT_EN set
+  *               to 0, works on the raw words before conversion.
+  * @{
+  *
+  */
+
+/* fixed point cell and fraction (0 .. 2^shift) of x over n points */
+static void ilps22qs_grid_pos_fx(int32_t x, uint8_t shift, uint8_t n,
+                                 uint8_t *i0, uint8_t *i1, int32_t *f)
+{
+  int32_t xi;
+
+  xi = (x < 0) ? -1 : (x / ((int32_t)1 << shift));
+  if ((n < 2U) || (xi < 0))
+  {
+    *i0 = 0U;
+    *f = 0;
+  }
+  else if (xi >= (int32_t)n - 1)
+  {
+    *i0 = (uint8_t)(n - 2U);
+    *f = (int32_t)1 << shift;
+  }
+  else
+  {
+    *i0 = (uint8_t)xi;
+    *f = x - (xi * ((int32_t)1 << shift));
+  }
+  *i1 = (n < 2U) ? *i0 : (uint8_t)(*i0 + 1U);
+}
+
+/**
+  * @brief  Batch temperature compensation, fixed point. The correction is
+  *         added to the raw field only, to be used before conversion;
+  *         in interleaved mode AH_QVAR samples are left untouched and the
+  *         correction is rounded to an even output LSB, so that the tag
+  *         bit is kept.
+  *
+  * @param  tc     compensation table, np >= 1, nt >= 1, shifts <= 12.(ptr)
+  * @param  md     the sensor conversion parameters.(ptr)
+  * @param  t_raw  temperature of the batch in 1/100 degC
+  * @param  data   samples to compensate, in place.(ptr)
+  * @param  num    number of samples
+  * @retval        0 -> no Error, -1 -> invalid parameters
+  *
+  */
+int32_t ilps22qs_tcomp_apply_fx(const ilps22qs_tcomp_fx_t *tc,
+                                ilps22qs_md_t *md, int16_t t_raw,
+                                ilps22qs_fifo_data_t *data, uint16_t num)
+{
+  const int16_t *r0;
+  const int16_t *r1;
+  int32_t ft, fp, c0, c1, c;
+  uint8_t t0, t1, p0, p1, sh, interleaved;
+  uint16_t i;
+
+  if ((tc == NULL) || (tc->corr == NULL) || (md == NULL) || (data == NULL) ||
+      (tc->np == 0U) || (tc->nt == 0U) ||
+      (tc->p_shift > 12U) || (tc->t_shift > 12U))
+  {
+    return -1;
+  }
+
+  /* raw word is hPa * 2^20 @1260hPa, hPa * 2^19 @4060hPa */
+  sh = (md->fs == ILPS22QS_4060hPa) ? 15U : 16U;
+  interleaved = (uint8_t)(md->interleaved_mode == 1U);
+
+  ilps22qs_grid_pos_fx((int32_t)t_raw - tc->t0, tc->t_shift, tc->nt,
+                       &t0, &t1, &ft);
+  r0 = &tc->corr[(uint16_t)t0 * tc->np];
+  r1 = &tc->corr[(uint16_t)t1 * tc->np];
+
+  for (i = 0U; i < num; i++)
+  {
+    /* bit 0 of XL (bit 8 of raw) tags an AH_QVAR sample */
+    if ((interleaved == 0U) || (((uint32_t)data[i].raw & 0x100U) == 0U))
+    {
+      /* pressure in hPa * 16 */
+      ilps22qs_grid_pos_fx((data[i].raw / ((int32_t)1 << sh)) - tc->p0,
+                           tc->p_shift, tc->np, &p0, &p1, &fp);
+      c0 = (int32_t)r0[p0] +
+           ((((int32_t)r0[p1] - r0[p0]) * fp) / ((int32_t)1 << tc->p_shift));
+      c1 = (int32_t)r1[p0] +
+           ((((int32_t)r1[p1] - r1[p0]) * fp) / ((int32_t)1 << tc->p_shift));
+      c = c0 + (((c1 - c0) * ft) / ((int32_t)1 << tc->t_shift));
+      if (interleaved != 0U)
+      {
+        /* keep bit 8 of raw: multiple of 2^9 raw units */
+        c = (c / ((int32_t)1 << (17U - sh))) * ((int32_t)1 << (17U - sh));
+      }
+      /* 1/4096 hPa to raw units */
+      data[i].raw += c * ((int32_t)1 << (sh - 8U));
+    }
+  }
+
+  return 0;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @}
+  *
+  */
+
+#endif /* ILPS22QS_PROC_EN */
@@ -0,0 +1,692 @@
+/**
+  ******************************************************************************
+  * @file    ilps22qs_proc.h
+  * @author  Sensors Software Solution Team
+  * @brief   This file contains all the functions prototypes for the
+  *          ilps22qs_proc.c host-side processing.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ILPS22QS_PROC_H
+#define ILPS22QS_PROC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "ilps22qs_reg.h"
+
+/** @defgroup  Processing selection
+  * @brief     ilps22qs_proc.c is compiled to an empty object unless
+  *            ILPS22QS_PROC_EN is set to 1, so that it can be built along
+  *            with the driver without changing the driver footprint.
+  *            It requires libm; with ILPS22QS_FLOAT_EN set to 0 only the
+  *            fixed-point functions are compiled (no float, no libm).
+  * @{
+  *
+  */
+
+#ifndef ILPS22QS_PROC_EN
+#define ILPS22QS_PROC_EN                 0 /* host-side processing (opt-in) */
+#endif /* ILPS22QS_PROC_EN */
+
+/**
+  * @}
+  *
+  */
+
+/** @addtogroup ILPS22QS_Proc
+  * @{
+  *
+  */
+
+#if (ILPS22QS_PROC_EN != 0)
+#if (ILPS22QS_FLOAT_EN != 0)
+#define ILPS22QS_QNH_STD_hPa             1013.25f
+
+typedef enum
+{
+  ILPS22QS_ALT_EXACT = 0x00, /* barometric formula through powf() */
+  ILPS22QS_ALT_FAST  = 0x01, /* polynomial, error < 0.1 m in 260..1260 hPa */
+} ilps22qs_alt_mode_t;
+float_t ilps22qs_from_hPa_to_m(float_t hpa, float_t qnh);
+float_t ilps22qs_from_hPa_to_m_fast(float_t hpa, float_t qnh);
+int32_t ilps22qs_altitude_get(const ilps22qs_fifo_data_t *data, uint16_t num,
+                              float_t qnh, ilps22qs_alt_mode_t mode,
+                              float_t *alt);
+
+float_t ilps22qs_odr_to_hz(ilps22qs_odr_t odr);
+float_t ilps22qs_press_rate_hz(const ilps22qs_md_t *md);
+
+#ifndef ILPS22QS_FILT_STAGES_MAX
+#define ILPS22QS_FILT_STAGES_MAX         4U
+#endif /* ILPS22QS_FILT_STAGES_MAX */
+
+#ifndef ILPS22QS_FILT_MOV_AVG_MAX
+#define ILPS22QS_FILT_MOV_AVG_MAX        32U
+#endif /* ILPS22QS_FILT_MOV_AVG_MAX */
+
+typedef enum
+{
+  ILPS22QS_FILT_BIQUAD  = 0x00, /* 2nd order Butterworth low-pass */
+  ILPS22QS_FILT_MOV_AVG = 0x01, /* moving average */
+  ILPS22QS_FILT_KALMAN  = 0x02, /* 1-D random walk Kalman smoother */
+} ilps22qs_filt_type_t;
+
+typedef struct
+{
+  ilps22qs_filt_type_t type;
+  struct
+  {
+    float_t b0, b1, b2, a1, a2;
+    float_t z1, z2;
+  } biquad;
+  struct
+  {
+    float_t buf[ILPS22QS_FILT_MOV_AVG_MAX];
+    float_t sum;
+    uint16_t len;
+    uint16_t idx;
+    uint16_t cnt;
+  } mov_avg;
+  struct
+  {
+    float_t q; /* process noise variance (hPa^2 per sample) */
+    float_t r; /* measurement noise variance (hPa^2) */
+    float_t x;
+    float_t p;
+  } kalman;
+} ilps22qs_filt_stage_t;
+
+typedef struct
+{
+  ilps22qs_filt_stage_t stage[ILPS22QS_FILT_STAGES_MAX];
+  uint8_t num;
+  uint8_t primed;
+  float_t offset; /* first sample, stages work on the deviation from it */
+} ilps22qs_filt_t;
+int32_t ilps22qs_filt_init(ilps22qs_filt_t *filt);
+int32_t ilps22qs_filt_reset(ilps22qs_filt_t *filt);
+int32_t ilps22qs_filt_biquad_add(ilps22qs_filt_t *filt,
+                                 const ilps22qs_md_t *md, float_t fc_hz);
+int32_t ilps22qs_filt_mov_avg_add(ilps22qs_filt_t *filt, uint16_t len);
+int32_t ilps22qs_filt_kalman_add(ilps22qs_filt_t *filt, float_t q, float_t r);
+int32_t ilps22qs_filt_apply(ilps22qs_filt_t *filt, ilps22qs_fifo_data_t *data,
+                            uint16_t num);
+
+typedef struct
+{
+  float_t *data;  /* circular window of samples, len entries */
+  int16_t *pos;   /* heap position of each window entry, len entries */
+  uint16_t *heap; /* max-heap / median / min-heap of entries, len entries */
+  float_t th_hpa; /* spike threshold from the median (<= 0: median output) */
+  uint16_t len;
+  uint16_t idx;
+  uint16_t cnt;
+} ilps22qs_median_t;
+int32_t ilps22qs_median_init(ilps22qs_median_t *med, float_t *data,
+                             int16_t *pos, uint16_t *heap, uint16_t len,
+                             float_t th_hpa);
+float_t ilps22qs_median_update(ilps22qs_median_t *med, float_t hpa);
+int32_t ilps22qs_median_apply(ilps22qs_median_t *med,
+                              ilps22qs_fifo_data_t *data, uint16_t num);
+
+typedef struct
+{
+  uint32_t n;
+  float_t mean_dev; /* mean minus first sample (precision at ~1000 hPa) */
+  float_t m2;       /* sum of squared deviations from the mean */
+  float_t min;
+  float_t max;
+  float_t first;    /* oldest sample */
+  float_t last;     /* newest sample */
+} ilps22qs_stats_t;
+int32_t ilps22qs_stats_init(ilps22qs_stats_t *stats);
+int32_t ilps22qs_stats_add(ilps22qs_stats_t *stats,
+                           const ilps22qs_fifo_data_t *data, uint16_t num);
+int32_t ilps22qs_stats_merge(ilps22qs_stats_t *stats,
+                             const ilps22qs_stats_t *next);
+float_t ilps22qs_stats_mean(const ilps22qs_stats_t *stats);
+float_t ilps22qs_stats_variance(const ilps22qs_stats_t *stats);
+float_t ilps22qs_stats_rate(const ilps22qs_stats_t *stats,
+                            const ilps22qs_md_t *md);
+
+typedef struct
+{
+  float_t val;
+  uint32_t seq;
+} ilps22qs_minmax_item_t;
+
+typedef struct
+{
+  ilps22qs_minmax_item_t *min_q; /* increasing values, len entries */
+  ilps22qs_minmax_item_t *max_q; /* decreasing values, len entries */
+  uint32_t seq;
+  uint16_t len;
+  uint16_t min_head;
+  uint16_t min_cnt;
+  uint16_t max_head;
+  uint16_t max_cnt;
+} ilps22qs_minmax_t;
+int32_t ilps22qs_minmax_init(ilps22qs_minmax_t *mm,
+                             ilps22qs_minmax_item_t *min_q,
+                             ilps22qs_minmax_item_t *max_q, uint16_t len);
+int32_t ilps22qs_minmax_add(ilps22qs_minmax_t *mm,
+                            const ilps22qs_fifo_data_t *data, uint16_t num);
+int32_t ilps22qs_minmax_get(const ilps22qs_minmax_t *mm, float_t *min,
+                            float_t *max);
+
+#ifndef ILPS22QS_ALLAN_LEVELS
+#define ILPS22QS_ALLAN_LEVELS            16U /* tau = 1 .. 2^15 samples */
+#endif /* ILPS22QS_ALLAN_LEVELS */
+
+typedef struct
+{
+  struct
+  {
+    float_t prev; /* last block average */
+    float_t pend; /* first half of the next level block */
+    float_t acc;  /* sum of squared differences of block averages */
+    uint32_t cnt; /* number of differences */
+    uint8_t has_prev : 1;
+    uint8_t has_pend : 1;
+  } level[ILPS22QS_ALLAN_LEVELS];
+  float_t offset;
+  uint8_t primed;
+} ilps22qs_allan_t;
+int32_t ilps22qs_allan_init(ilps22qs_allan_t *allan);
+int32_t ilps22qs_allan_add(ilps22qs_allan_t *allan,
+                           const ilps22qs_fifo_data_t *data, uint16_t num);
+int32_t ilps22qs_allan_dev_get(const ilps22qs_allan_t *allan, uint8_t level,
+                               const ilps22qs_md_t *md, float_t *tau_s,
+                               float_t *adev);
+int32_t ilps22qs_allan_floor_get(const ilps22qs_allan_t *allan,
+                                 const ilps22qs_md_t *md, float_t *tau_s,
+                                 float_t *adev);
+#if (ILPS22QS_FIFO_EN != 0)
+int32_t ilps22qs_allan_sweep(const stmdev_ctx_t *ctx, ilps22qs_md_t *md,
+                             uint8_t num, uint32_t samples,
+                             ilps22qs_allan_t *allan);
+#endif /* ILPS22QS_FIFO_EN */
+
+/*
+ * Sample log block layout (little endian, ILPS22QS_LOG_BLOCK_SIZE bytes):
+ *  [0..1]   magic 0x51 0x50
+ *  [2]      format version
+ *  [3]      device id
+ *  [4..7]   block sequence number
+ *  [8..15]  timestamp of the first sample, ticks
+ *  [16..19] sample period, ticks
+ *  [20..21] number of samples
+ *  [22..23] reserved, 0
+ *  [24..27] CRC-32 of the whole block with this field set to 0
+ *  [28..]   samples: FIFO word as read from XL, L, H (3 bytes each),
+ *           unused bytes set to 0
+ * A tick is 1 / ILPS22QS_LOG_TICK_HZ s: 1 us by default, so the period of
+ * every ODR is exact and the 64-bit timestamp does not wrap.
+ */
+#ifndef ILPS22QS_LOG_BLOCK_SIZE
+#define ILPS22QS_LOG_BLOCK_SIZE          512U
+#endif /* ILPS22QS_LOG_BLOCK_SIZE */
+#ifndef ILPS22QS_LOG_TICK_HZ
+#define ILPS22QS_LOG_TICK_HZ             1000000U /* 1 tick = 1 us */
+#endif /* ILPS22QS_LOG_TICK_HZ */
+#define ILPS22QS_LOG_HDR_SIZE            28U
+#define ILPS22QS_LOG_SAMPLES             ((ILPS22QS_LOG_BLOCK_SIZE - \
+                                           ILPS22QS_LOG_HDR_SIZE) / 3U)
+#define ILPS22QS_LOG_VERSION             0x02U
+
+typedef int32_t (*ilps22qs_log_flush_ptr)(void *handle, const uint8_t *block,
+                                          uint16_t len);
+
+typedef struct
+{
+  uint8_t dev_id;
+  uint32_t seq;
+  uint64_t t0;    /* ticks */
+  uint32_t dt;    /* ticks */
+  uint16_t cnt;
+} ilps22qs_log_hdr_t;
+
+typedef struct
+{
+  ilps22qs_log_flush_ptr flush;
+  void *handle;
+  ilps22qs_log_hdr_t hdr;
+  uint8_t block[ILPS22QS_LOG_BLOCK_SIZE];
+} ilps22qs_log_t;
+int32_t ilps22qs_log_init(ilps22qs_log_t *log, uint8_t dev_id, uint32_t dt,
+                          ilps22qs_log_flush_ptr flush, void *handle);
+int32_t ilps22qs_log_append(ilps22qs_log_t *log, uint64_t t,
+                            const ilps22qs_fifo_data_t *data, uint16_t num);
+int32_t ilps22qs_log_flush(ilps22qs_log_t *log);
+int32_t ilps22qs_log_block_check(const uint8_t *block, ilps22qs_log_hdr_t *hdr);
+
+typedef struct
+{
+  uint32_t block; /* block number in the log */
+  uint64_t t0;    /* timestamp of the first sample */
+  uint64_t t_end; /* timestamp of the last sample */
+} ilps22qs_log_idx_t;
+
+typedef struct
+{
+  const uint8_t *log; /* log image, i.e. a memory-mapped file */
+  size_t blocks;
+  ilps22qs_log_idx_t *idx;
+  uint32_t idx_cnt;
+  uint8_t dev_id;
+} ilps22qs_log_reader_t;
+
+typedef struct
+{
+  uint32_t pos; /* next index entry */
+  uint64_t t1;
+  uint64_t t2;
+} ilps22qs_log_iter_t;
+int32_t ilps22qs_log_reader_init(ilps22qs_log_reader_t *rd, const uint8_t *log,
+                                 size_t size, uint8_t dev_id,
+                                 ilps22qs_log_idx_t *idx, uint32_t idx_max);
+int32_t ilps22qs_log_range_first(const ilps22qs_log_reader_t *rd, uint64_t t1,
+                                 uint64_t t2, ilps22qs_log_iter_t *it);
+int32_t ilps22qs_log_range_next(const ilps22qs_log_reader_t *rd,
+                                ilps22qs_log_iter_t *it, ilps22qs_md_t *md,
+                                ilps22qs_fifo_data_t *data, uint64_t *t0,
+                                uint16_t *num);
+
+/*
+ * Compressed frame of up to 255 FIFO words: delta or delta-of-delta,
+ * zigzag and bit-packed with one width per channel (pressure and, in
+ * interleaved mode, AH_QVAR). Worst case frame size for n words:
+ */
+#define ILPS22QS_CODEC_SIZE_MAX(n)       (16U + ((((n) * 26U) + 7U) / 8U))
+
+int32_t ilps22qs_codec_encode(const ilps22qs_fifo_data_t *data, uint8_t num,
+                              uint8_t interleaved, uint8_t *out,
+                              uint16_t out_max, uint16_t *out_len);
+int32_t ilps22qs_codec_decode(const uint8_t *in, uint16_t in_len,
+                              ilps22qs_md_t *md, ilps22qs_fifo_data_t *data,
+                              uint8_t *num, uint16_t *used);
+
+typedef uint32_t (*ilps22qs_tick_ptr)(void);
+
+typedef struct
+{
+  uint8_t write;   /* 1 = write_reg, 0 = read_reg */
+  uint8_t reg;
+  uint16_t len;
+  uint32_t off;    /* payload offset */
+  uint32_t tick;   /* tick at the call (0 without tick source) */
+} ilps22qs_trace_rec_t;
+
+typedef struct
+{
+  uint32_t transactions;
+  uint32_t bytes;
+  uint32_t span;   /* ticks between the first and the last transaction */
+} ilps22qs_trace_stats_t;
+
+typedef struct
+{
+  stmdev_ctx_t bus;            /* recording: real bus */
+  ilps22qs_tick_ptr tick;      /* optional time source */
+  ilps22qs_trace_rec_t *rec;
+  uint32_t rec_max;
+  uint32_t rec_cnt;
+  uint8_t *payload;
+  uint32_t payload_max;
+  uint32_t payload_len;
+  uint32_t pos;                /* replay: next record */
+  uint32_t last_tick;
+  ilps22qs_trace_stats_t live; /* transactions of the current run */
+  uint8_t replay;
+  uint8_t diverged;            /* replay: sequence mismatch detected */
+} ilps22qs_trace_t;
+int32_t ilps22qs_trace_rec_init(ilps22qs_trace_t *trace, const stmdev_ctx_t *bus,
+                                ilps22qs_tick_ptr tick,
+                                ilps22qs_trace_rec_t *rec, uint32_t rec_max,
+                                uint8_t *payload, uint32_t payload_max,
+                                stmdev_ctx_t *ctx);
+int32_t ilps22qs_trace_replay_init(ilps22qs_trace_t *trace,
+                                   ilps22qs_tick_ptr tick,
+                                   ilps22qs_trace_rec_t *rec, uint32_t rec_cnt,
+                                   uint8_t *payload, uint32_t payload_len,
+                                   stmdev_ctx_t *ctx);
+int32_t ilps22qs_trace_stats_get(const ilps22qs_trace_rec_t *rec, uint32_t cnt,
+                                 ilps22qs_trace_stats_t *stats);
+
+typedef struct
+{
+  float_t band_hpa;
+  float_t hyst_hpa;
+  float_t ref_hpa;    /* reference, read back from REF_P at each event */
+  uint32_t events;    /* reported changes */
+  uint32_t spurious;  /* excursions within the hysteresis */
+} ilps22qs_woc_t;
+#if (ILPS22QS_INT_EN != 0) && (ILPS22QS_REF_EN != 0)
+int32_t ilps22qs_woc_start(const stmdev_ctx_t *ctx, ilps22qs_md_t *md,
+                           float_t band_hpa, float_t hyst_hpa,
+                           ilps22qs_woc_t *woc);
+int32_t ilps22qs_woc_event(const stmdev_ctx_t *ctx, ilps22qs_md_t *md,
+                           ilps22qs_woc_t *woc, float_t *hpa,
+                           uint8_t *changed);
+int32_t ilps22qs_woc_stop(const stmdev_ctx_t *ctx);
+#endif /* ILPS22QS_INT_EN && ILPS22QS_REF_EN */
+
+typedef struct
+{
+  uint32_t t;                 /* timestamp of the poll that saw the event */
+  float_t period_s;           /* sample period in s */
+  uint8_t pre;                /* data[0 .. pre - 1]: up to the trigger */
+  uint8_t post;               /* data[pre .. pre + post - 1] */
+  uint8_t lag;                /* samples between the trigger and the poll */
+  ilps22qs_fifo_data_t *data; /* caller buffer of at least pre + post */
+} ilps22qs_capt_rec_t;
+
+typedef struct
+{
+  ilps22qs_woc_t woc;
+  ilps22qs_md_t md;
+  uint8_t pre;
+  uint8_t post;
+  uint32_t captures;
+} ilps22qs_capt_t;
+#if (ILPS22QS_FIFO_EN != 0) && (ILPS22QS_INT_EN != 0) && (ILPS22QS_REF_EN != 0)
+int32_t ilps22qs_capt_arm(const stmdev_ctx_t *ctx, ilps22qs_md_t *md,
+                          float_t band_hpa, uint8_t pre, uint8_t post,
+                          ilps22qs_capt_t *capt);
+int32_t ilps22qs_capt_event(const stmdev_ctx_t *ctx, ilps22qs_capt_t *capt,
+                            uint32_t t, ilps22qs_capt_rec_t *rec);
+int32_t ilps22qs_capt_disarm(const stmdev_ctx_t *ctx);
+#endif /* ILPS22QS_FIFO_EN && ILPS22QS_INT_EN && ILPS22QS_REF_EN */
+
+typedef struct
+{
+  float_t offset_hpa;  /* measured - reference, before correction */
+  int16_t opc;         /* value programmed in RPDS */
+  uint8_t used;        /* samples averaged */
+  uint8_t rejected;    /* outliers */
+} ilps22qs_opc_cal_t;
+#if (ILPS22QS_FIFO_EN != 0) && (ILPS22QS_REF_EN != 0)
+int32_t ilps22qs_opc_calibrate(const stmdev_ctx_t *ctx, ilps22qs_md_t *md,
+                               float_t ref_hpa, ilps22qs_fifo_data_t *buf,
+                               uint8_t num, ilps22qs_opc_cal_t *cal);
+#endif /* ILPS22QS_FIFO_EN && ILPS22QS_REF_EN */
+
+typedef struct
+{
+  const float_t *corr; /* nt rows of np corrections in hPa */
+  float_t p0;          /* first pressure point in hPa */
+  float_t p_step;      /* pressure step in hPa */
+  float_t t0;          /* first temperature point in degC */
+  float_t t_step;      /* temperature step in degC */
+  uint8_t np;
+  uint8_t nt;
+} ilps22qs_tcomp_t;
+
+float_t ilps22qs_tcomp_get(const ilps22qs_tcomp_t *tc, float_t hpa,
+                           float_t deg_c);
+int32_t ilps22qs_tcomp_apply(const ilps22qs_tcomp_t *tc, float_t deg_c,
+                             ilps22qs_fifo_data_t *data, uint16_t num);
+
+typedef enum
+{
+  ILPS22QS_QVAR_EV_NONE  = 0,
+  ILPS22QS_QVAR_EV_START = 1, /* touch / presence detected */
+  ILPS22QS_QVAR_EV_END   = 2, /* touch / presence released */
+} ilps22qs_qvar_ev_t;
+
+typedef struct
+{
+  uint16_t idx;               /* sample index in the batch */
+  ilps22qs_qvar_ev_t ev;
+} ilps22qs_qvar_evt_t;
+
+typedef struct
+{
+  float_t baseline;           /* mV */
+  float_t noise;              /* mean absolute deviation, mV */
+  float_t alpha;
+  float_t k;
+  float_t min_mv;
+  uint32_t max_active;        /* samples, 0: no limit */
+  uint32_t active_cnt;        /* samples since the event start */
+  uint8_t debounce;
+  uint8_t cnt;
+  uint8_t active;
+  uint8_t primed;
+} ilps22qs_qvar_det_t;
+int32_t ilps22qs_qvar_det_init(ilps22qs_qvar_det_t *det, float_t alpha,
+                               float_t k, float_t min_mv, uint8_t debounce,
+                               uint32_t max_active);
+ilps22qs_qvar_ev_t ilps22qs_qvar_det_update(ilps22qs_qvar_det_t *det,
+                                            float_t mv);
+int32_t ilps22qs_qvar_det_apply(ilps22qs_qvar_det_t *det,
+                                const ilps22qs_fifo_data_t *data,
+                                uint16_t num, ilps22qs_qvar_evt_t *ev,
+                                uint16_t ev_max, uint16_t *ev_num);
+
+#define ILPS22QS_PAIR_TAG_PRESS          0U
+#define ILPS22QS_PAIR_TAG_QVAR           1U
+#define ILPS22QS_PAIR_TAG_NONE           2U
+
+typedef struct
+{
+  float_t hpa;
+  float_t mv;     /* AH/QVAR interpolated at the pressure sample time */
+  uint32_t n;     /* stream slot of the pressure sample, t = n * period_s */
+} ilps22qs_pair_data_t;
+
+typedef struct
+{
+  float_t period_s;
+  float_t p_hpa;  /* pressure waiting for the next AH/QVAR sample */
+  float_t q_mv;   /* last AH/QVAR sample */
+  uint32_t n;     /* stream slot of the next sample */
+  uint32_t p_n;
+  uint32_t slips; /* phase slips (lost samples) detected */
+  uint8_t has_p;
+  uint8_t has_q;
+  uint8_t last_tag;
+} ilps22qs_pair_t;
+int32_t ilps22qs_pair_init(ilps22qs_pair_t *pair, ilps22qs_odr_t odr);
+int32_t ilps22qs_pair_apply(ilps22qs_pair_t *pair,
+                            const ilps22qs_fifo_data_t *data, uint16_t num,
+                            ilps22qs_pair_data_t *out, uint16_t out_max,
+                            uint16_t *out_num);
+
+typedef struct
+{
+  ilps22qs_md_t *prof;  /* from the slowest to the fastest */
+  float_t tau_s;
+  float_t up_th;        /* hPa/s */
+  float_t down_th;      /* hPa/s */
+  float_t hold_s;
+  float_t smooth;       /* smoothed pressure, hPa */
+  float_t rate;         /* smoothed rate of change, hPa/s */
+  float_t quiet_s;      /* time spent below down_th */
+  uint32_t seq;         /* samples processed */
+  uint32_t switch_at;   /* seq at the last switch */
+  uint32_t switches;
+  uint8_t num;
+  uint8_t cur;          /* current profile */
+  uint8_t primed;
+} ilps22qs_odr_ctl_t;
+int32_t ilps22qs_odr_ctl_init(const stmdev_ctx_t *ctx, ilps22qs_odr_ctl_t *ctl,
+                              ilps22qs_md_t *prof, uint8_t num, uint8_t start,
+                              float_t tau_s, float_t up_th, float_t down_th,
+                              float_t hold_s);
+int32_t ilps22qs_odr_ctl_apply(const stmdev_ctx_t *ctx, ilps22qs_odr_ctl_t *ctl,
+                               const ilps22qs_fifo_data_t *data, uint16_t num,
+                               uint8_t *switched);
+
+#ifndef ILPS22QS_TREND_SEC_N
+#define ILPS22QS_TREND_SEC_N             120U /* 2 min of 1 s buckets */
+#endif /* ILPS22QS_TREND_SEC_N */
+
+#ifndef ILPS22QS_TREND_MIN_N
+#define ILPS22QS_TREND_MIN_N             180U /* 3 h of 1 min buckets */
+#endif /* ILPS22QS_TREND_MIN_N */
+
+#ifndef ILPS22QS_TREND_HOUR_N
+#define ILPS22QS_TREND_HOUR_N            72U  /* 3 days of 1 h buckets */
+#endif /* ILPS22QS_TREND_HOUR_N */
+
+#define ILPS22QS_TREND_SEC               0U
+#define ILPS22QS_TREND_MIN               1U
+#define ILPS22QS_TREND_HOUR              2U
+#define ILPS22QS_TREND_LEVELS            3U
+
+typedef struct
+{
+  float_t first;
+  float_t sum_dev;   /* sum of (sample - first) */
+  float_t min;
+  float_t max;
+  uint32_t idx;      /* start time in units of the level */
+  uint32_t cnt;
+} ilps22qs_trend_bkt_t;
+
+typedef struct
+{
+  float_t min;
+  float_t max;
+  float_t mean;
+  uint32_t cnt;
+} ilps22qs_trend_val_t;
+
+typedef struct
+{
+  ilps22qs_trend_bkt_t cur[ILPS22QS_TREND_LEVELS]; /* open buckets */
+  ilps22qs_trend_bkt_t sec[ILPS22QS_TREND_SEC_N];
+  ilps22qs_trend_bkt_t min[ILPS22QS_TREND_MIN_N];
+  ilps22qs_trend_bkt_t hour[ILPS22QS_TREND_HOUR_N];
+} ilps22qs_trend_t;
+int32_t ilps22qs_trend_init(ilps22qs_trend_t *tr);
+int32_t ilps22qs_trend_add(ilps22qs_trend_t *tr, uint32_t t_s, float_t hpa);
+int32_t ilps22qs_trend_apply(ilps22qs_trend_t *tr, uint32_t t0_s, float_t dt_s,
+                             const ilps22qs_fifo_data_t *data, uint16_t num);
+int32_t ilps22qs_trend_get(ilps22qs_trend_t *tr, uint8_t level,
+                           uint16_t ago, ilps22qs_trend_val_t *val);
+int32_t ilps22qs_trend_delta(ilps22qs_trend_t *tr, uint8_t level, uint16_t n,
+                             float_t *dp);
+
+#ifndef ILPS22QS_DIFF_BUF_N
+#define ILPS22QS_DIFF_BUF_N              256U /* per sensor, >= 2 FIFO batches */
+#endif /* ILPS22QS_DIFF_BUF_N */
+
+typedef struct
+{
+  float_t t[ILPS22QS_DIFF_BUF_N];   /* s from t_ref_ms */
+  float_t hpa[ILPS22QS_DIFF_BUF_N];
+  float_t dt_s;                     /* sample period of the last batch */
+  uint16_t head;
+  uint16_t cnt;
+} ilps22qs_diff_ch_t;
+
+typedef struct
+{
+  uint32_t t_ms;
+  float_t dp_hpa;                   /* a - b - offset */
+} ilps22qs_diff_data_t;
+
+typedef struct
+{
+  ilps22qs_diff_ch_t ch[2];
+  uint32_t t_ref_ms;
+  float_t dt_s;
+  float_t t_next;                   /* next grid time, s from t_ref_ms */
+  float_t offset;                   /* zero offset, hPa */
+  float_t zero_sum;
+  uint16_t zero_n;
+  uint16_t zero_left;
+  uint8_t has_ref;
+  uint8_t started;
+} ilps22qs_diff_t;
+int32_t ilps22qs_diff_init(ilps22qs_diff_t *pair, float_t dt_s);
+int32_t ilps22qs_diff_push(ilps22qs_diff_t *pair, uint8_t ch, uint32_t t0_ms,
+                           float_t dt_s, const ilps22qs_fifo_data_t *data,
+                           uint16_t num);
+int32_t ilps22qs_diff_zero(ilps22qs_diff_t *pair, uint16_t n);
+int32_t ilps22qs_diff_get(ilps22qs_diff_t *pair, ilps22qs_diff_data_t *out,
+                          uint16_t out_max, uint16_t *out_num);
+
+#ifndef ILPS22QS_SPECT_WIN_MAX
+#define ILPS22QS_SPECT_WIN_MAX           128U
+#endif /* ILPS22QS_SPECT_WIN_MAX */
+
+#ifndef ILPS22QS_SPECT_BANDS_MAX
+#define ILPS22QS_SPECT_BANDS_MAX         4U
+#endif /* ILPS22QS_SPECT_BANDS_MAX */
+
+#ifndef ILPS22QS_SPECT_BINS_MAX
+#define ILPS22QS_SPECT_BINS_MAX          32U
+#endif /* ILPS22QS_SPECT_BINS_MAX */
+
+typedef struct
+{
+  uint32_t seq;                               /* samples up to this window */
+  float_t energy[ILPS22QS_SPECT_BANDS_MAX];   /* hPa^2 */
+} ilps22qs_spect_data_t;
+
+typedef struct
+{
+  float_t buf[ILPS22QS_SPECT_WIN_MAX];
+  float_t coeff[ILPS22QS_SPECT_BINS_MAX];     /* 2 cos(2 pi k / win) */
+  float_t scale[ILPS22QS_SPECT_BINS_MAX];
+  uint8_t band[ILPS22QS_SPECT_BINS_MAX];
+  uint32_t seq;
+  uint16_t win;
+  uint16_t hop;
+  uint16_t pos;
+  uint16_t cnt;
+  uint16_t since;
+  uint8_t bins;
+  uint8_t bands;
+} ilps22qs_spect_t;
+int32_t ilps22qs_spect_init(ilps22qs_spect_t *spec, const ilps22qs_md_t *md,
+                            uint16_t win, uint16_t hop, const float_t *f_lo,
+                            const float_t *f_hi, uint8_t bands);
+int32_t ilps22qs_spect_apply(ilps22qs_spect_t *spec,
+                             const ilps22qs_fifo_data_t *data, uint16_t num,
+                             ilps22qs_spect_data_t *out, uint16_t out_max,
+                             uint16_t *out_num);
+#endif /* ILPS22QS_FLOAT_EN */
+
+typedef struct
+{
+  const int16_t *corr; /* nt rows of np corrections in 1/4096 hPa */
+  int32_t p0;          /* first pressure point in hPa * 16 */
+  int16_t t0;          /* first temperature point in 1/100 degC */
+  uint8_t p_shift;     /* pressure step 2^p_shift in hPa * 16 */
+  uint8_t t_shift;     /* temperature step 2^t_shift in 1/100 degC */
+  uint8_t np;
+  uint8_t nt;
+} ilps22qs_tcomp_fx_t;
+int32_t ilps22qs_tcomp_apply_fx(const ilps22qs_tcomp_fx_t *tc,
+                                ilps22qs_md_t *md, int16_t t_raw,
+                                ilps22qs_fifo_data_t *data, uint16_t num);
+#endif /* ILPS22QS_PROC_EN */
+
+/**
+  *@}
+  *
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ILPS22QS_PROC_H */
@@ -85,6 +85,90 @@ int32_t __weak ilps22qs_write_reg(const stmdev_ctx_t *ctx, uint8_t reg, uint8_t
   return ret;
 }
 
+/**
+  * @brief  Read a list of non-adjacent register blocks
+  *
+  * @param  ctx   read / write interface definitions(ptr)
+  * @param  seg   list of register blocks to read(ptr)
+  * @param  num   number of blocks in the list
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t __weak ilps22qs_read_reg_seg(const stmdev_ctx_t *ctx,
+                                     const ilps22qs_reg_seg_t *seg, uint8_t num)
+{
+  int32_t ret = 0;
+  uint8_t i;
+
+  if ((ctx == NULL) || (seg == NULL))
+  {
+    return -1;
+  }
+
+  for (i = 0U; (i < num) && (ret == 0); i++)
+  {
+    ret = ilps22qs_read_reg(ctx, seg[i].reg, seg[i].data, seg[i].len);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Write a list of non-adjacent register blocks
+  *
+  * @param  ctx   read / write interface definitions(ptr)
+  * @param  seg   list of register blocks to write(ptr)
+  * @param  num   number of blocks in the list
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t __weak ilps22qs_write_reg_seg(const stmdev_ctx_t *ctx,
+                                      const ilps22qs_reg_seg_t *seg, uint8_t num)
+{
+  int32_t ret = 0;
+  uint8_t i;
+
+  if ((ctx == NULL) || (seg == NULL))
+  {
+    return -1;
+  }
+
+  for (i = 0U; (i < num) && (ret == 0); i++)
+  {
+    ret = ilps22qs_write_reg(ctx, seg[i].reg, seg[i].data, seg[i].len);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Take the lock of a register group before a read-modify-write
+  *         sequence. Groups are always taken in ascending order.
+  *         Data and status reads never take a lock.
+  *
+  * @param  ctx   read / write interface definitions(ptr)
+  * @param  grp   register group to lock
+  *
+  */
+void __weak ilps22qs_lock(const stmdev_ctx_t *ctx, ilps22qs_lock_grp_t grp)
+{
+  (void)ctx;
+  (void)grp;
+}
+
+/**
+  * @brief  Release the lock of a register group.
+  *
+  * @param  ctx   read / write interface definitions(ptr)
+  * @param  grp   register group to unlock
+  *
+  */
+void __weak ilps22qs_unlock(const stmdev_ctx_t *ctx, ilps22qs_lock_grp_t grp)
+{
+  (void)ctx;
+  (void)grp;
+}
+
 /**
   * @}
   *
@@ -105,6 +189,59 @@ static void bytecpy(uint8_t *target, uint8_t *source)
   }
 }
 
+/* hPa per LSB of the left-aligned raw word (power of two, exact) */
+static float_t ilps22qs_hpa_sensitivity(ilps22qs_fs_t fs)
+{
+  float_t sens;
+
+  switch (fs)
+  {
+    case ILPS22QS_1260hPa:
+      sens = 1.0f / 1048576.0f;   /* 4096.0f * 256 */
+      break;
+    case ILPS22QS_4060hPa:
+      sens = 1.0f / 524288.0f;    /* 2048.0f * 256 */
+      break;
+    default:
+      sens = 0.0f;
+      break;
+  }
+
+  return sens;
+}
+
+/*
+ * Decode one 24-bit output word (XL, L, H). In interleaved mode bit 0 of XL
+ * tags an AH_QVAR sample, otherwise the word is a pressure sample.
+ */
+static void ilps22qs_press_decode(const uint8_t *buff, uint8_t interleaved,
+                                  float_t sens, int32_t *raw, float_t *hpa,
+                                  int32_t *lsb)
+{
+  *raw = (int32_t)buff[2];
+  *raw = (*raw * 256) + (int32_t)buff[1];
+  *raw = (*raw * 256) + (int32_t)buff[0];
+  *raw = *raw * 256;
+
+  if ((interleaved != 0U) && ((buff[0] & 0x1U) != 0U))
+  {
+    /* data is a AH_QVAR sample */
+    *lsb = (*raw / 256); /* shift 8bit left */
+    *hpa = 0.0f;
+  }
+  else
+  {
+    /* data is a pressure sample */
+#if (ILPS22QS_FLOAT_EN != 0)
+    *hpa = (float_t)*raw * sens;
+#else
+    (void)sens;
+    *hpa = 0.0f;
+#endif /* ILPS22QS_FLOAT_EN */
+    *lsb = 0;
+  }
+}
+
 /**
   * @}
   *
@@ -117,6 +254,7 @@ static void bytecpy(uint8_t *target, uint8_t *source)
   *
   */
 
+#if (ILPS22QS_FLOAT_EN != 0)
 float_t ilps22qs_from_fs1260_to_hPa(int32_t lsb)
 {
   return ((float_t)lsb / 1048576.0f);   /* 4096.0f * 256 */
@@ -136,6 +274,7 @@ float_t ilps22qs_from_lsb_to_mv(int32_t lsb)
 {
   return ((float_t)lsb) / 438000.0f;
 }
+#endif /* ILPS22QS_FLOAT_EN */
 
 /**
   * @}
@@ -169,6 +308,7 @@ int32_t ilps22qs_id_get(const stmdev_ctx_t *ctx, ilps22qs_id_t *val)
   return ret;
 }
 
+#if (ILPS22QS_BUS_CONF_EN != 0)
 /**
   * @brief  Configures the bus operating mode.[set]
   *
@@ -181,26 +321,26 @@ int32_t ilps22qs_bus_mode_set(const stmdev_ctx_t *ctx, ilps22qs_bus_mode_t *val)
 {
   ilps22qs_i3c_if_ctrl_t i3c_if_ctrl = {0};
   ilps22qs_if_ctrl_t if_ctrl = {0};
+  ilps22qs_reg_seg_t seg[2];
   int32_t ret = {0};
 
-  ret = ilps22qs_read_reg(ctx, ILPS22QS_IF_CTRL, (uint8_t *)&if_ctrl, 1);
+  seg[0].reg = ILPS22QS_IF_CTRL;
+  seg[0].data = (uint8_t *)&if_ctrl;
+  seg[0].len = 1;
+  seg[1].reg = ILPS22QS_I3C_IF_CTRL;
+  seg[1].data = (uint8_t *)&i3c_if_ctrl;
+  seg[1].len = 1;
+
+  ilps22qs_lock(ctx, ILPS22QS_LOCK_IF);
+  ret = ilps22qs_read_reg_seg(ctx, seg, 2);
   if (ret == 0)
   {
     if_ctrl.i2c_i3c_dis = ((uint8_t)val->interface & 0x02U) >> 1;
     if_ctrl.en_spi_read = ((uint8_t)val->interface & 0x01U);
-    ret = ilps22qs_write_reg(ctx, ILPS22QS_IF_CTRL, (uint8_t *)&if_ctrl, 1);
-  }
-  if (ret == 0)
-  {
-    ret = ilps22qs_read_reg(ctx, ILPS22QS_I3C_IF_CTRL,
-                            (uint8_t *)&i3c_if_ctrl, 1);
-  }
-  if (ret == 0)
-  {
     i3c_if_ctrl.asf_on = (uint8_t)val->filter & 0x01U;
-    ret = ilps22qs_write_reg(ctx, ILPS22QS_I3C_IF_CTRL,
-                             (uint8_t *)&i3c_if_ctrl, 1);
+    ret = ilps22qs_write_reg_seg(ctx, seg, 2);
   }
+  ilps22qs_unlock(ctx, ILPS22QS_LOCK_IF);
   return ret;
 }
 
@@ -216,18 +356,19 @@ int32_t ilps22qs_bus_mode_get(const stmdev_ctx_t *ctx, ilps22qs_bus_mode_t *val)
 {
   ilps22qs_i3c_if_ctrl_t i3c_if_ctrl = {0};
   ilps22qs_if_ctrl_t if_ctrl = {0};
+  ilps22qs_reg_seg_t seg[2];
   int32_t ret = {0};
 
-  ret = ilps22qs_read_reg(ctx, ILPS22QS_IF_CTRL, (uint8_t *)&if_ctrl, 1);
+  seg[0].reg = ILPS22QS_IF_CTRL;
+  seg[0].data = (uint8_t *)&if_ctrl;
+  seg[0].len = 1;
+  seg[1].reg = ILPS22QS_I3C_IF_CTRL;
+  seg[1].data = (uint8_t *)&i3c_if_ctrl;
+  seg[1].len = 1;
+
+  ret = ilps22qs_read_reg_seg(ctx, seg, 2);
   if (ret == 0)
   {
-    ret = ilps22qs_read_reg(ctx, ILPS22QS_I3C_IF_CTRL,
-                            (uint8_t *)&i3c_if_ctrl, 1);
-    if (ret != 0)
-    {
-      return ret;
-    }
-
     switch (if_ctrl.i2c_i3c_dis << 1)
     {
       case 0x00:
@@ -257,6 +398,7 @@ int32_t ilps22qs_bus_mode_get(const stmdev_ctx_t *ctx, ilps22qs_bus_mode_t *val)
   }
   return ret;
 }
+#endif /* ILPS22QS_BUS_CONF_EN */
 
 /**
   * @brief  Configures the bus operating mode.[get]
@@ -275,6 +417,8 @@ int32_t ilps22qs_init_set(const stmdev_ctx_t *ctx, ilps22qs_init_t val)
   uint8_t reg[2] = {0}, cnt = 0;
   int32_t ret = {0};
 
+  /* the lock covers the read-modify-write only, not the polling below */
+  ilps22qs_lock(ctx, ILPS22QS_LOCK_CTRL);
   ret = ilps22qs_read_reg(ctx, ILPS22QS_CTRL_REG2, reg, 2);
   if (ret == 0)
   {
@@ -287,71 +431,6 @@ int32_t ilps22qs_init_set(const stmdev_ctx_t *ctx, ilps22qs_init_t val)
         ctrl_reg2.boot = PROPERTY_ENABLE;
         ret = ilps22qs_write_reg(ctx, ILPS22QS_CTRL_REG2,
                                  (uint8_t *)&ctrl_reg2, 1);
-        if (ret != 0)
-        {
-          break;
-        }
-
-        do
-        {
-          ret = ilps22qs_read_reg(ctx, ILPS22QS_INT_SOURCE, (uint8_t *)&int_src, 1);
-          if (ret != 0)
-          {
-            break;
-          }
-
-          /* boot procedure ended correctly */
-          if (int_src.boot_on == 0U)
-          {
-            break;
-          }
-
-          if (ctx->mdelay != NULL)
-          {
-            ctx->mdelay(10); /* 10ms of boot time */
-          }
-        } while (cnt++ < 5U);
-
-        if (cnt >= 5U)
-        {
-          ret = -1;  /* boot procedure failed */
-        }
-
-        break;
-      case ILPS22QS_RESET:
-        ctrl_reg2.swreset = PROPERTY_ENABLE;
-        ret = ilps22qs_write_reg(ctx, ILPS22QS_CTRL_REG2,
-                                 (uint8_t *)&ctrl_reg2, 1);
-        if (ret != 0)
-        {
-          break;
-        }
-
-        do
-        {
-          ret = ilps22qs_status_get(ctx, &status);
-          if (ret != 0)
-          {
-            break;
-          }
-
-          /* sw-reset procedure ended correctly */
-          if (status.sw_reset == 0U)
-          {
-            break;
-          }
-
-          if (ctx->mdelay != NULL)
-          {
-            ctx->mdelay(1); /* should be 50 us */
-          }
-        } while (cnt++ < 5U);
-
-        if (cnt >= 5U)
-        {
-          ret = -1;  /* sw-reset procedure failed */
-        }
-
         break;
       case ILPS22QS_DRV_RDY:
         ctrl_reg2.bdu = PROPERTY_ENABLE;
@@ -360,6 +439,7 @@ int32_t ilps22qs_init_set(const stmdev_ctx_t *ctx, ilps22qs_init_t val)
         bytecpy(&reg[1], (uint8_t *)&ctrl_reg3);
         ret = ilps22qs_write_reg(ctx, ILPS22QS_CTRL_REG2, reg, 2);
         break;
+      case ILPS22QS_RESET:
       default:
         ctrl_reg2.swreset = PROPERTY_ENABLE;
         ret = ilps22qs_write_reg(ctx, ILPS22QS_CTRL_REG2,
@@ -368,6 +448,64 @@ int32_t ilps22qs_init_set(const stmdev_ctx_t *ctx, ilps22qs_init_t val)
     }
   }
 
+  ilps22qs_unlock(ctx, ILPS22QS_LOCK_CTRL);
+
+  if ((ret == 0) && (val == ILPS22QS_BOOT))
+  {
+    do
+    {
+      ret = ilps22qs_read_reg(ctx, ILPS22QS_INT_SOURCE, (uint8_t *)&int_src, 1);
+      if (ret != 0)
+      {
+        break;
+      }
+
+      /* boot procedure ended correctly */
+      if (int_src.boot_on == 0U)
+      {
+        break;
+      }
+
+      if (ctx->mdelay != NULL)
+      {
+        ctx->mdelay(10); /* 10ms of boot time */
+      }
+    } while (cnt++ < 5U);
+
+    if (cnt >= 5U)
+    {
+      ret = -1;  /* boot procedure failed */
+    }
+  }
+
+  if ((ret == 0) && (val == ILPS22QS_RESET))
+  {
+    do
+    {
+      ret = ilps22qs_status_get(ctx, &status);
+      if (ret != 0)
+      {
+        break;
+      }
+
+      /* sw-reset procedure ended correctly */
+      if (status.sw_reset == 0U)
+      {
+        break;
+      }
+
+      if (ctx->mdelay != NULL)
+      {
+        ctx->mdelay(1); /* should be 50 us */
+      }
+    } while (cnt++ < 5U);
+
+    if (cnt >= 5U)
+    {
+      ret = -1;  /* sw-reset procedure failed */
+    }
+  }
+
   return ret;
 }
 
@@ -385,23 +523,23 @@ int32_t ilps22qs_status_get(const stmdev_ctx_t *ctx, ilps22qs_stat_t *val)
   ilps22qs_int_source_t int_source = {0};
   ilps22qs_ctrl_reg2_t ctrl_reg2 = {0};
   ilps22qs_status_t status = {0};
+  ilps22qs_reg_seg_t seg[4];
   int32_t ret = {0};
 
-  ret = ilps22qs_read_reg(ctx, ILPS22QS_CTRL_REG2,
-                          (uint8_t *)&ctrl_reg2, 1);
-  if (ret == 0)
-  {
-    ret = ilps22qs_read_reg(ctx, ILPS22QS_INT_SOURCE, (uint8_t *)&int_source, 1);
-  }
-  if (ret == 0)
-  {
-    ret = ilps22qs_read_reg(ctx, ILPS22QS_STATUS, (uint8_t *)&status, 1);
-  }
-  if (ret == 0)
-  {
-    ret = ilps22qs_read_reg(ctx, ILPS22QS_INTERRUPT_CFG,
-                            (uint8_t *)&interrupt_cfg, 1);
-  }
+  seg[0].reg = ILPS22QS_CTRL_REG2;
+  seg[0].data = (uint8_t *)&ctrl_reg2;
+  seg[0].len = 1;
+  seg[1].reg = ILPS22QS_INT_SOURCE;
+  seg[1].data = (uint8_t *)&int_source;
+  seg[1].len = 1;
+  seg[2].reg = ILPS22QS_STATUS;
+  seg[2].data = (uint8_t *)&status;
+  seg[2].len = 1;
+  seg[3].reg = ILPS22QS_INTERRUPT_CFG;
+  seg[3].data = (uint8_t *)&interrupt_cfg;
+  seg[3].len = 1;
+
+  ret = ilps22qs_read_reg_seg(ctx, seg, 4);
   if (ret != 0)
   {
     return ret;
@@ -418,6 +556,7 @@ int32_t ilps22qs_status_get(const stmdev_ctx_t *ctx, ilps22qs_stat_t *val)
   return ret;
 }
 
+#if (ILPS22QS_BUS_CONF_EN != 0)
 /**
   * @brief  Electrical pin configuration.[set]
   *
@@ -431,6 +570,7 @@ int32_t ilps22qs_pin_conf_set(const stmdev_ctx_t *ctx, ilps22qs_pin_conf_t *val)
   ilps22qs_if_ctrl_t if_ctrl = {0};
   int32_t ret = {0};
 
+  ilps22qs_lock(ctx, ILPS22QS_LOCK_IF);
   ret = ilps22qs_read_reg(ctx, ILPS22QS_IF_CTRL, (uint8_t *)&if_ctrl, 1);
 
   if (ret == 0)
@@ -440,6 +580,7 @@ int32_t ilps22qs_pin_conf_set(const stmdev_ctx_t *ctx, ilps22qs_pin_conf_t *val)
     ret = ilps22qs_write_reg(ctx, ILPS22QS_IF_CTRL, (uint8_t *)&if_ctrl, 1);
   }
 
+  ilps22qs_unlock(ctx, ILPS22QS_LOCK_IF);
   return ret;
 }
 
@@ -467,6 +608,7 @@ int32_t ilps22qs_pin_conf_get(const stmdev_ctx_t *ctx, ilps22qs_pin_conf_t *val)
 
   return ret;
 }
+#endif /* ILPS22QS_BUS_CONF_EN */
 
 /**
   * @brief  Get the status of all the interrupt sources.[get]
@@ -482,20 +624,20 @@ int32_t ilps22qs_all_sources_get(const stmdev_ctx_t *ctx,
   ilps22qs_fifo_status2_t fifo_status2 = {0};
   ilps22qs_int_source_t int_source = {0};
   ilps22qs_status_t status = {0};
+  ilps22qs_reg_seg_t seg[3];
   int32_t ret = {0};
 
-  ret = ilps22qs_read_reg(ctx, ILPS22QS_STATUS, (uint8_t *)&status, 1);
-  if (ret == 0)
-  {
-    ret = ilps22qs_read_reg(ctx, ILPS22QS_INT_SOURCE,
-                            (uint8_t *)&int_source, 1);
-  }
-  if (ret == 0)
-  {
-    ret = ilps22qs_read_reg(ctx, ILPS22QS_FIFO_STATUS2,
-                            (uint8_t *)&fifo_status2, 1);
-  }
-
+  seg[0].reg = ILPS22QS_STATUS;
+  seg[0].data = (uint8_t *)&status;
+  seg[0].len = 1;
+  seg[1].reg = ILPS22QS_INT_SOURCE;
+  seg[1].data = (uint8_t *)&int_source;
+  seg[1].len = 1;
+  seg[2].reg = ILPS22QS_FIFO_STATUS2;
+  seg[2].data = (uint8_t *)&fifo_status2;
+  seg[2].len = 1;
+
+  ret = ilps22qs_read_reg_seg(ctx, seg, 3);
   if (ret != 0)
   {
     return ret;
@@ -527,11 +669,21 @@ int32_t ilps22qs_mode_set(const stmdev_ctx_t *ctx, ilps22qs_md_t *val)
   ilps22qs_ctrl_reg2_t ctrl_reg2 = {0};
   ilps22qs_ctrl_reg3_t ctrl_reg3 = {0};
   ilps22qs_fifo_ctrl_t fifo_ctrl = {0};
-  uint8_t odr_save = 0, ah_qvar_en_save = 0;
+  uint8_t ah_qvar_en_save = 0, interleaved;
+  ilps22qs_reg_seg_t seg[2];
   uint8_t reg[3] = {0};
   int32_t ret = {0};
 
-  ret = ilps22qs_read_reg(ctx, ILPS22QS_CTRL_REG1, reg, 3);
+  seg[0].reg = ILPS22QS_CTRL_REG1;
+  seg[0].data = reg;
+  seg[0].len = 3;
+  seg[1].reg = ILPS22QS_FIFO_CTRL;
+  seg[1].data = (uint8_t *)&fifo_ctrl;
+  seg[1].len = 1;
+
+  ilps22qs_lock(ctx, ILPS22QS_LOCK_CTRL);
+  ilps22qs_lock(ctx, ILPS22QS_LOCK_FIFO);
+  ret = ilps22qs_read_reg_seg(ctx, seg, 2);
 
   if (ret == 0)
   {
@@ -539,48 +691,47 @@ int32_t ilps22qs_mode_set(const stmdev_ctx_t *ctx, ilps22qs_md_t *val)
     bytecpy((uint8_t *)&ctrl_reg2, &reg[1]);
     bytecpy((uint8_t *)&ctrl_reg3, &reg[2]);
 
-    /* handle interleaved mode setting */
-    if (ctrl_reg1.odr != 0x0U)
-    {
-      /* power-down */
-      odr_save = ctrl_reg1.odr;
-      ctrl_reg1.odr = 0x0U;
-      ret += ilps22qs_write_reg(ctx, ILPS22QS_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
-    }
+    interleaved = val->interleaved_mode & 0x01U;
 
-    if (ctrl_reg3.ah_qvar_en != 0U)
+    /* interleaved mode can be changed only in power-down with QVAR off */
+    if ((ctrl_reg3.ah_qvar_p_auto_en != interleaved) ||
+        (fifo_ctrl.ah_qvar_p_fifo_en != interleaved))
     {
-      /* disable QVAR */
-      ah_qvar_en_save = ctrl_reg3.ah_qvar_en & 0x01U;
-      ctrl_reg3.ah_qvar_en = 0;
-      ret += ilps22qs_write_reg(ctx, ILPS22QS_CTRL_REG3, (uint8_t *)&ctrl_reg3, 1);
-    }
+      if (ctrl_reg1.odr != 0x0U)
+      {
+        /* power-down */
+        ctrl_reg1.odr = 0x0U;
+        ret += ilps22qs_write_reg(ctx, ILPS22QS_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
+      }
 
-    /* set interleaved mode (0 or 1) */
-    ctrl_reg3.ah_qvar_p_auto_en = val->interleaved_mode & 0x01U;
-    ret += ilps22qs_write_reg(ctx, ILPS22QS_CTRL_REG3, (uint8_t *)&ctrl_reg3, 1);
+      if (ctrl_reg3.ah_qvar_en != 0U)
+      {
+        /* disable QVAR */
+        ah_qvar_en_save = ctrl_reg3.ah_qvar_en & 0x01U;
+        ctrl_reg3.ah_qvar_en = 0;
+        ret += ilps22qs_write_reg(ctx, ILPS22QS_CTRL_REG3, (uint8_t *)&ctrl_reg3, 1);
+      }
 
-    /* set FIFO interleaved mode (0 or 1) */
-    ret += ilps22qs_read_reg(ctx, ILPS22QS_FIFO_CTRL, (uint8_t *)&fifo_ctrl, 1);
-    fifo_ctrl.ah_qvar_p_fifo_en = val->interleaved_mode & 0x01U;
-    ret += ilps22qs_write_reg(ctx, ILPS22QS_FIFO_CTRL, (uint8_t *)&fifo_ctrl, 1);
+      /* set interleaved mode (0 or 1) */
+      ctrl_reg3.ah_qvar_p_auto_en = interleaved & 0x01U;
+      ret += ilps22qs_write_reg(ctx, ILPS22QS_CTRL_REG3, (uint8_t *)&ctrl_reg3, 1);
 
-    if (ah_qvar_en_save != 0U)
-    {
-      /* restore ah_qvar_en back to previous setting */
-      ctrl_reg3.ah_qvar_en = ah_qvar_en_save & 0x01U;
-    }
+      /* set FIFO interleaved mode (0 or 1) */
+      fifo_ctrl.ah_qvar_p_fifo_en = interleaved & 0x01U;
+      ret += ilps22qs_write_reg(ctx, ILPS22QS_FIFO_CTRL, (uint8_t *)&fifo_ctrl, 1);
 
-    if (odr_save != 0U)
-    {
-      /* restore odr back to previous setting */
-      ctrl_reg1.odr = odr_save & 0x0FU;
+      if (ah_qvar_en_save != 0U)
+      {
+        /* restore ah_qvar_en back to previous setting */
+        ctrl_reg3.ah_qvar_en = ah_qvar_en_save & 0x01U;
+      }
     }
 
+    /* all the remaining fields are applied with a single burst write */
     ctrl_reg1.odr = (uint8_t)val->odr & 0x0FU;
     ctrl_reg1.avg = (uint8_t)val->avg & 0x07U;
     ctrl_reg2.en_lpfp = (uint8_t)val->lpf & 0x01U;
-    ctrl_reg2.lfpf_cfg = ((uint8_t)val->lpf & 0x02U) >> 2;
+    ctrl_reg2.lfpf_cfg = ((uint8_t)val->lpf & 0x02U) >> 1;
     ctrl_reg2.fs_mode = (uint8_t)val->fs & 0x01U;
 
     bytecpy(&reg[0], (uint8_t *)&ctrl_reg1);
@@ -589,6 +740,8 @@ int32_t ilps22qs_mode_set(const stmdev_ctx_t *ctx, ilps22qs_md_t *val)
     ret += ilps22qs_write_reg(ctx, ILPS22QS_CTRL_REG1, reg, 3);
   }
 
+  ilps22qs_unlock(ctx, ILPS22QS_LOCK_FIFO);
+  ilps22qs_unlock(ctx, ILPS22QS_LOCK_CTRL);
   return ret;
 }
 
@@ -694,7 +847,7 @@ int32_t ilps22qs_mode_get(const stmdev_ctx_t *ctx, ilps22qs_md_t *val)
         break;
     }
 
-    switch ((ctrl_reg2.lfpf_cfg << 2) | ctrl_reg2.en_lpfp)
+    switch ((ctrl_reg2.lfpf_cfg << 1) | ctrl_reg2.en_lpfp)
     {
       case 0x00:
         val->lpf = ILPS22QS_LPF_DISABLE;
@@ -729,16 +882,19 @@ int32_t ilps22qs_trigger_sw(const stmdev_ctx_t *ctx, ilps22qs_md_t *md)
 
   if (md->odr == ILPS22QS_ONE_SHOT)
   {
+    ilps22qs_lock(ctx, ILPS22QS_LOCK_CTRL);
     ret = ilps22qs_read_reg(ctx, ILPS22QS_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
     ctrl_reg2.oneshot = PROPERTY_ENABLE;
     if (ret == 0)
     {
       ret = ilps22qs_write_reg(ctx, ILPS22QS_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
     }
+    ilps22qs_unlock(ctx, ILPS22QS_LOCK_CTRL);
   }
   return ret;
 }
 
+#if (ILPS22QS_QVAR_EN != 0)
 /**
   * @brief  AH/QVAR function enable.[set]
   *
@@ -752,6 +908,7 @@ int32_t ilps22qs_ah_qvar_en_set(const stmdev_ctx_t *ctx, uint8_t val)
   ilps22qs_ctrl_reg3_t ctrl_reg3 = {0};
   int32_t ret = {0};
 
+  ilps22qs_lock(ctx, ILPS22QS_LOCK_CTRL);
   ret = ilps22qs_read_reg(ctx, ILPS22QS_CTRL_REG3, (uint8_t *)&ctrl_reg3, 1);
 
   if (ret == 0)
@@ -760,6 +917,7 @@ int32_t ilps22qs_ah_qvar_en_set(const stmdev_ctx_t *ctx, uint8_t val)
     ret = ilps22qs_write_reg(ctx, ILPS22QS_CTRL_REG3, (uint8_t *)&ctrl_reg3, 1);
   }
 
+  ilps22qs_unlock(ctx, ILPS22QS_LOCK_CTRL);
   return ret;
 }
 
@@ -786,6 +944,7 @@ int32_t ilps22qs_ah_qvar_en_get(const stmdev_ctx_t *ctx, uint8_t *val)
 
   return ret;
 }
+#endif /* ILPS22QS_QVAR_EN */
 
 /**
   * @brief  Sensor data.[get]
@@ -809,58 +968,18 @@ int32_t ilps22qs_data_get(const stmdev_ctx_t *ctx, ilps22qs_md_t *md,
   }
 
   /* pressure conversion */
-  data->pressure.raw = (int32_t)buff[2];
-  data->pressure.raw = (data->pressure.raw * 256) + (int32_t) buff[1];
-  data->pressure.raw = (data->pressure.raw * 256) + (int32_t) buff[0];
-  data->pressure.raw = data->pressure.raw * 256;
-
-  if (md->interleaved_mode == 1U)
-  {
-    if ((buff[0] & 0x1U) == 0U)
-    {
-      /* data is a pressure sample */
-      switch (md->fs)
-      {
-        case ILPS22QS_1260hPa:
-          data->pressure.hpa = ilps22qs_from_fs1260_to_hPa(data->pressure.raw);
-          break;
-        case ILPS22QS_4060hPa:
-          data->pressure.hpa = ilps22qs_from_fs4000_to_hPa(data->pressure.raw);
-          break;
-        default:
-          data->pressure.hpa = 0.0f;
-          break;
-      }
-      data->ah_qvar.lsb = 0;
-    }
-    else
-    {
-      /* data is a AH_QVAR sample */
-      data->ah_qvar.lsb = (data->pressure.raw / 256); /* shift 8bit left */
-      data->pressure.hpa = 0.0f;
-    }
-  }
-  else
-  {
-    switch (md->fs)
-    {
-      case ILPS22QS_1260hPa:
-        data->pressure.hpa = ilps22qs_from_fs1260_to_hPa(data->pressure.raw);
-        break;
-      case ILPS22QS_4060hPa:
-        data->pressure.hpa = ilps22qs_from_fs4000_to_hPa(data->pressure.raw);
-        break;
-      default:
-        data->pressure.hpa = 0.0f;
-        break;
-    }
-    data->ah_qvar.lsb = 0;
-  }
-
+  ilps22qs_press_decode(buff, (uint8_t)(md->interleaved_mode == 1U),
+                        ilps22qs_hpa_sensitivity(md->fs),
+                        &data->pressure.raw, &data->pressure.hpa,
+                        &data->ah_qvar.lsb);
 
   /* temperature conversion */
   data->heat.raw = (int16_t)(buff[3] | ((uint16_t)buff[4] << 8));
+#if (ILPS22QS_FLOAT_EN != 0)
   data->heat.deg_c = ilps22qs_from_lsb_to_celsius(data->heat.raw);
+#else
+  data->heat.deg_c = 0.0f;
+#endif /* ILPS22QS_FLOAT_EN */
 
   return ret;
 }
@@ -916,6 +1035,7 @@ int32_t ilps22qs_temperature_raw_get(const stmdev_ctx_t *ctx, int16_t *buff)
   return ret;
 }
 
+#if (ILPS22QS_QVAR_EN != 0)
 /**
   * @brief  AH/QVAR data read.[get]
   *
@@ -944,10 +1064,15 @@ int32_t ilps22qs_ah_qvar_data_get(const stmdev_ctx_t *ctx,
   data->raw = (data->raw * 256);
   data->lsb = (data->raw / 256); /* shift 8bit left */
 
+#if (ILPS22QS_FLOAT_EN != 0)
   data->mv = ilps22qs_from_lsb_to_mv(data->lsb);
+#else
+  data->mv = 0.0f;
+#endif /* ILPS22QS_FLOAT_EN */
 
   return ret;
 }
+#endif /* ILPS22QS_QVAR_EN */
 
 /**
   * @}
@@ -962,6 +1087,7 @@ int32_t ilps22qs_ah_qvar_data_get(const stmdev_ctx_t *ctx,
   *
   */
 
+#if (ILPS22QS_FIFO_EN != 0)
 /**
   * @brief  FIFO operation mode selection.[set]
   *
@@ -975,6 +1101,7 @@ int32_t ilps22qs_fifo_mode_set(const stmdev_ctx_t *ctx, ilps22qs_operation_t val
   ilps22qs_fifo_ctrl_t fifo_ctrl = {0};
   int32_t ret = {0};
 
+  ilps22qs_lock(ctx, ILPS22QS_LOCK_FIFO);
   ret = ilps22qs_read_reg(ctx, ILPS22QS_FIFO_CTRL, (uint8_t *)&fifo_ctrl, 1);
   if (ret == 0)
   {
@@ -983,6 +1110,7 @@ int32_t ilps22qs_fifo_mode_set(const stmdev_ctx_t *ctx, ilps22qs_operation_t val
 
     ret = ilps22qs_write_reg(ctx, ILPS22QS_FIFO_CTRL, (uint8_t *)&fifo_ctrl, 1);
   }
+  ilps22qs_unlock(ctx, ILPS22QS_LOCK_FIFO);
   return ret;
 }
 
@@ -1053,6 +1181,7 @@ int32_t ilps22qs_fifo_watermark_set(const stmdev_ctx_t *ctx, uint8_t val)
     goto exit;
   }
 
+  ilps22qs_lock(ctx, ILPS22QS_LOCK_FIFO);
   ret = ilps22qs_read_reg(ctx, ILPS22QS_FIFO_WTM, (uint8_t *)&fifo_wtm, 1);
   if (ret == 0)
   {
@@ -1060,6 +1189,7 @@ int32_t ilps22qs_fifo_watermark_set(const stmdev_ctx_t *ctx, uint8_t val)
 
     ret = ilps22qs_write_reg(ctx, ILPS22QS_FIFO_WTM, (uint8_t *)&fifo_wtm, 1);
   }
+  ilps22qs_unlock(ctx, ILPS22QS_LOCK_FIFO);
 
 exit:
   return ret;
@@ -1099,13 +1229,15 @@ int32_t ilps22qs_fifo_stop_on_wtm_set(const stmdev_ctx_t *ctx, ilps22qs_fifo_eve
   ilps22qs_fifo_ctrl_t fifo_ctrl = {0};
   int32_t ret = {0};
 
+  ilps22qs_lock(ctx, ILPS22QS_LOCK_FIFO);
   ret = ilps22qs_read_reg(ctx, ILPS22QS_FIFO_CTRL, (uint8_t *)&fifo_ctrl, 1);
   if (ret == 0)
   {
-    fifo_ctrl.stop_on_wtm = (val == ILPS22QS_FIFO_EV_WTM) ? 1 : 0;
+    fifo_ctrl.stop_on_wtm = (*val == ILPS22QS_FIFO_EV_WTM) ? 1U : 0U;
 
     ret = ilps22qs_write_reg(ctx, ILPS22QS_FIFO_CTRL, (uint8_t *)&fifo_ctrl, 1);
   }
+  ilps22qs_unlock(ctx, ILPS22QS_LOCK_FIFO);
   return ret;
 }
 
@@ -1170,9 +1302,15 @@ int32_t ilps22qs_fifo_data_get(const stmdev_ctx_t *ctx, uint8_t samp,
                                ilps22qs_md_t *md, ilps22qs_fifo_data_t *data)
 {
   uint8_t fifo_data[3] = {0};
+  uint8_t interleaved;
   uint8_t i = {0};
+  float_t sens;
   int32_t ret = 0;
 
+  /* conversion parameters do not change within a batch */
+  interleaved = (uint8_t)(md->interleaved_mode == 1U);
+  sens = ilps22qs_hpa_sensitivity(md->fs);
+
   for (i = 0U; i < samp; i++)
   {
     ret += ilps22qs_read_reg(ctx, ILPS22QS_FIFO_DATA_OUT_PRESS_XL, fifo_data, 3);
@@ -1180,56 +1318,13 @@ int32_t ilps22qs_fifo_data_get(const stmdev_ctx_t *ctx, uint8_t samp,
     {
       return ret;
     }
-    data[i].raw = (int32_t)fifo_data[2];
-    data[i].raw = (data[i].raw * 256) + (int32_t)fifo_data[1];
-    data[i].raw = (data[i].raw * 256) + (int32_t)fifo_data[0];
-    data[i].raw = (data[i].raw * 256);
-    if (md->interleaved_mode == 1U)
-    {
-      if ((fifo_data[0] & 0x1U) == 0U)
-      {
-        /* data is a pressure sample */
-        switch (md->fs)
-        {
-          case ILPS22QS_1260hPa:
-            data[i].hpa = ilps22qs_from_fs1260_to_hPa(data[i].raw);
-            break;
-          case ILPS22QS_4060hPa:
-            data[i].hpa = ilps22qs_from_fs4000_to_hPa(data[i].raw);
-            break;
-          default:
-            data[i].hpa = 0.0f;
-            break;
-        }
-        data[i].lsb = 0;
-      }
-      else
-      {
-        /* data is a AH_QVAR sample */
-        data[i].lsb = (data[i].raw / 256); /* shift 8bit left */
-        data[i].hpa = 0.0f;
-      }
-    }
-    else
-    {
-      switch (md->fs)
-      {
-        case ILPS22QS_1260hPa:
-          data[i].hpa = ilps22qs_from_fs1260_to_hPa(data[i].raw);
-          break;
-        case ILPS22QS_4060hPa:
-          data[i].hpa = ilps22qs_from_fs4000_to_hPa(data[i].raw);
-          break;
-        default:
-          data[i].hpa = 0.0f;
-          break;
-      }
-      data[i].lsb = 0;
-    }
+    ilps22qs_press_decode(fifo_data, interleaved, sens,
+                          &data[i].raw, &data[i].hpa, &data[i].lsb);
   }
 
   return ret;
 }
+#endif /* ILPS22QS_FIFO_EN */
 
 /**
   * @}
@@ -1244,6 +1339,7 @@ int32_t ilps22qs_fifo_data_get(const stmdev_ctx_t *ctx, uint8_t samp,
   *
   */
 
+#if (ILPS22QS_INT_EN != 0)
 /**
   * @brief  Interrupt pins hardware signal configuration.[set]
   *
@@ -1258,6 +1354,7 @@ int32_t ilps22qs_interrupt_mode_set(const stmdev_ctx_t *ctx,
   ilps22qs_interrupt_cfg_t interrupt_cfg = {0};
   int32_t ret = 0;
 
+  ilps22qs_lock(ctx, ILPS22QS_LOCK_INT);
   ret += ilps22qs_read_reg(ctx, ILPS22QS_INTERRUPT_CFG,
                            (uint8_t *)&interrupt_cfg, 1);
   if (ret == 0)
@@ -1266,6 +1363,7 @@ int32_t ilps22qs_interrupt_mode_set(const stmdev_ctx_t *ctx,
     ret = ilps22qs_write_reg(ctx, ILPS22QS_INTERRUPT_CFG,
                              (uint8_t *)&interrupt_cfg, 1);
   }
+  ilps22qs_unlock(ctx, ILPS22QS_LOCK_INT);
   return ret;
 }
 
@@ -1294,7 +1392,9 @@ int32_t ilps22qs_interrupt_mode_get(const stmdev_ctx_t *ctx,
 
   return ret;
 }
+#endif /* ILPS22QS_INT_EN */
 
+#if (ILPS22QS_QVAR_EN != 0)
 /**
   * @brief  AH function disable
   *
@@ -1311,6 +1411,7 @@ int32_t ilps22qs_ah_qvar_disable(const stmdev_ctx_t *ctx)
 
   return ret;
 }
+#endif /* ILPS22QS_QVAR_EN */
 
 /**
   * @}
@@ -1325,6 +1426,7 @@ int32_t ilps22qs_ah_qvar_disable(const stmdev_ctx_t *ctx)
   *
   */
 
+#if (ILPS22QS_INT_EN != 0)
 /**
   * @brief  Configuration of Wake-up and Wake-up to Sleep .[set]
   *
@@ -1342,6 +1444,7 @@ int32_t ilps22qs_int_on_threshold_mode_set(const stmdev_ctx_t *ctx,
   uint8_t reg[3] = {0};
   int32_t ret = {0};
 
+  ilps22qs_lock(ctx, ILPS22QS_LOCK_INT);
   ret = ilps22qs_read_reg(ctx, ILPS22QS_INTERRUPT_CFG, reg, 3);
   if (ret == 0)
   {
@@ -1361,6 +1464,7 @@ int32_t ilps22qs_int_on_threshold_mode_set(const stmdev_ctx_t *ctx,
     ret = ilps22qs_write_reg(ctx, ILPS22QS_INTERRUPT_CFG, reg, 3);
   }
 
+  ilps22qs_unlock(ctx, ILPS22QS_LOCK_INT);
   return ret;
 }
 
@@ -1398,6 +1502,7 @@ int32_t ilps22qs_int_on_threshold_mode_get(const stmdev_ctx_t *ctx,
 
   return ret;
 }
+#endif /* ILPS22QS_INT_EN */
 
 /**
   * @}
@@ -1412,6 +1517,7 @@ int32_t ilps22qs_int_on_threshold_mode_get(const stmdev_ctx_t *ctx,
   *
   */
 
+#if (ILPS22QS_REF_EN != 0)
 /**
   * @brief  Configuration of Wake-up and Wake-up to Sleep .[set]
   *
@@ -1425,6 +1531,7 @@ int32_t ilps22qs_reference_mode_set(const stmdev_ctx_t *ctx, ilps22qs_ref_md_t *
   ilps22qs_interrupt_cfg_t interrupt_cfg = {0};
   int32_t ret = {0};
 
+  ilps22qs_lock(ctx, ILPS22QS_LOCK_INT);
   ret = ilps22qs_read_reg(ctx, ILPS22QS_INTERRUPT_CFG,
                           (uint8_t *)&interrupt_cfg, 1);
   if (ret == 0)
@@ -1439,6 +1546,7 @@ int32_t ilps22qs_reference_mode_set(const stmdev_ctx_t *ctx, ilps22qs_ref_md_t *
     ret = ilps22qs_write_reg(ctx, ILPS22QS_INTERRUPT_CFG,
                              (uint8_t *)&interrupt_cfg, 1);
   }
+  ilps22qs_unlock(ctx, ILPS22QS_LOCK_INT);
   return ret;
 }
 
@@ -1527,6 +1635,7 @@ int32_t ilps22qs_opc_get(const stmdev_ctx_t *ctx, int16_t *val)
 
   return ret;
 }
+#endif /* ILPS22QS_REF_EN */
 
 /**
   * @}
@@ -30,6 +30,49 @@ extern "C" {
 #include <stddef.h>
 #include <math.h>
 
+/** @defgroup  Feature selection
+  * @brief     Each feature group can be compiled out by defining its macro
+  *            to 0, either on the compiler command line or in an
+  *            ilps22qs_conf.h file (see ilps22qs_conf_template.h) included
+  *            when ILPS22QS_USE_CONF_H is defined.
+  *            Data read, conversion mode and init are always available.
+  * @{
+  *
+  */
+
+#ifdef ILPS22QS_USE_CONF_H
+#include "ilps22qs_conf.h"
+#endif /* ILPS22QS_USE_CONF_H */
+
+#ifndef ILPS22QS_FIFO_EN
+#define ILPS22QS_FIFO_EN                 1 /* FIFO functions */
+#endif /* ILPS22QS_FIFO_EN */
+
+#ifndef ILPS22QS_QVAR_EN
+#define ILPS22QS_QVAR_EN                 1 /* AH/QVAR functions */
+#endif /* ILPS22QS_QVAR_EN */
+
+#ifndef ILPS22QS_INT_EN
+#define ILPS22QS_INT_EN                  1 /* interrupt and threshold */
+#endif /* ILPS22QS_INT_EN */
+
+#ifndef ILPS22QS_REF_EN
+#define ILPS22QS_REF_EN                  1 /* reference pressure and OPC */
+#endif /* ILPS22QS_REF_EN */
+
+#ifndef ILPS22QS_BUS_CONF_EN
+#define ILPS22QS_BUS_CONF_EN             1 /* bus mode and pin config */
+#endif /* ILPS22QS_BUS_CONF_EN */
+
+#ifndef ILPS22QS_FLOAT_EN
+#define ILPS22QS_FLOAT_EN                1 /* hPa / degC / mV conversion */
+#endif /* ILPS22QS_FLOAT_EN */
+
+/**
+  * @}
+  *
+  */
+
 /** @addtogroup ILPS22QS
   * @{
   *
@@ -186,6 +229,13 @@ typedef struct
 /** Device Identification (Who am I) **/
 #define ILPS22QS_ID                      0xB4U
 
+/** SPI protocol: MSb of the address byte selects read (1) / write (0).
+  * Multi-byte access relies on IF_ADD_INC (set by ILPS22QS_DRV_RDY),
+  * no extra auto-increment bit is needed in the address byte.
+  */
+#define ILPS22QS_SPI_READ_BIT            0x80U
+#define ILPS22QS_SPI_ADD_MASK            0x7FU
+
 /**
   * @}
   *
@@ -493,10 +543,49 @@ int32_t ilps22qs_read_reg(const stmdev_ctx_t *ctx, uint8_t reg,
 int32_t ilps22qs_write_reg(const stmdev_ctx_t *ctx, uint8_t reg,
                            uint8_t *data, uint16_t len);
 
+/*
+ * Scatter-gather access to a list of non-adjacent register blocks.
+ * The default implementation issues one read_reg/write_reg per segment;
+ * platforms able to queue several transfers in one bus request can
+ * overwrite them (__weak) to serve the whole list at once.
+ */
+typedef struct
+{
+  uint8_t reg;
+  uint8_t *data;
+  uint16_t len;
+} ilps22qs_reg_seg_t;
+
+int32_t ilps22qs_read_reg_seg(const stmdev_ctx_t *ctx,
+                              const ilps22qs_reg_seg_t *seg, uint8_t num);
+int32_t ilps22qs_write_reg_seg(const stmdev_ctx_t *ctx,
+                               const ilps22qs_reg_seg_t *seg, uint8_t num);
+
+/*
+ * Read-modify-write setters take the lock of the register group they
+ * touch, so that concurrent setters on the same device do not lose
+ * updates. The default implementation does nothing; multi-threaded
+ * applications overwrite them (__weak) with one mutex per group,
+ * e.g. indexed by ctx->handle. Data and status reads never lock.
+ */
+typedef enum
+{
+  ILPS22QS_LOCK_CTRL = 0, /* CTRL_REG1..3 */
+  ILPS22QS_LOCK_FIFO = 1, /* FIFO_CTRL, FIFO_WTM */
+  ILPS22QS_LOCK_INT  = 2, /* INTERRUPT_CFG, THS_P_L/H */
+  ILPS22QS_LOCK_IF   = 3, /* IF_CTRL, I3C_IF_CTRL */
+} ilps22qs_lock_grp_t;
+#define ILPS22QS_LOCK_GRP_NUM  4U
+
+void ilps22qs_lock(const stmdev_ctx_t *ctx, ilps22qs_lock_grp_t grp);
+void ilps22qs_unlock(const stmdev_ctx_t *ctx, ilps22qs_lock_grp_t grp);
+
+#if (ILPS22QS_FLOAT_EN != 0)
 extern float_t ilps22qs_from_fs1260_to_hPa(int32_t lsb);
 extern float_t ilps22qs_from_fs4000_to_hPa(int32_t lsb);
 extern float_t ilps22qs_from_lsb_to_celsius(int16_t lsb);
 extern float_t ilps22qs_from_lsb_to_mv(int32_t lsb);
+#endif /* ILPS22QS_FLOAT_EN */
 
 typedef struct
 {
@@ -521,8 +610,10 @@ typedef struct
   ilps22qs_interface_t interface;
   ilps22qs_filter_t filter;
 } ilps22qs_bus_mode_t;
+#if (ILPS22QS_BUS_CONF_EN != 0)
 int32_t ilps22qs_bus_mode_set(const stmdev_ctx_t *ctx, ilps22qs_bus_mode_t *val);
 int32_t ilps22qs_bus_mode_get(const stmdev_ctx_t *ctx, ilps22qs_bus_mode_t *val);
+#endif /* ILPS22QS_BUS_CONF_EN */
 
 typedef enum
 {
@@ -550,8 +641,10 @@ typedef struct
   uint8_t sda_pull_up : 1; /* 1 = pull-up enabled */
   uint8_t cs_pull_up  : 1; /* 1 = pull-up enabled */
 } ilps22qs_pin_conf_t;
+#if (ILPS22QS_BUS_CONF_EN != 0)
 int32_t ilps22qs_pin_conf_set(const stmdev_ctx_t *ctx, ilps22qs_pin_conf_t *val);
 int32_t ilps22qs_pin_conf_get(const stmdev_ctx_t *ctx, ilps22qs_pin_conf_t *val);
+#endif /* ILPS22QS_BUS_CONF_EN */
 
 typedef struct
 {
@@ -646,8 +739,10 @@ typedef struct
   int32_t lsb; /* 24 bit properly right aligned */
   int32_t raw; /* 32 bit signed-left algned  format left  */
 } ilps22qs_ah_qvar_data_t;
+#if (ILPS22QS_QVAR_EN != 0)
 int32_t ilps22qs_ah_qvar_data_get(const stmdev_ctx_t *ctx,
                                   ilps22qs_ah_qvar_data_t *data);
+#endif /* ILPS22QS_QVAR_EN */
 
 typedef enum
 {
@@ -660,11 +755,13 @@ typedef enum
 } ilps22qs_operation_t;
 
 
+#if (ILPS22QS_FIFO_EN != 0)
 int32_t ilps22qs_fifo_mode_set(const stmdev_ctx_t *ctx, ilps22qs_operation_t val);
 int32_t ilps22qs_fifo_mode_get(const stmdev_ctx_t *ctx, ilps22qs_operation_t *val);
 
 int32_t ilps22qs_fifo_watermark_set(const stmdev_ctx_t *ctx, uint8_t val);
 int32_t ilps22qs_fifo_watermark_get(const stmdev_ctx_t *ctx, uint8_t *val);
+#endif /* ILPS22QS_FIFO_EN */
 
 typedef enum
 {
@@ -672,10 +769,12 @@ typedef enum
   ILPS22QS_FIFO_EV_FULL          = 0x1,
 } ilps22qs_fifo_event_t;
 
+#if (ILPS22QS_FIFO_EN != 0)
 int32_t ilps22qs_fifo_stop_on_wtm_set(const stmdev_ctx_t *ctx, ilps22qs_fifo_event_t *val);
 int32_t ilps22qs_fifo_stop_on_wtm_get(const stmdev_ctx_t *ctx, ilps22qs_fifo_event_t *val);
 
 int32_t ilps22qs_fifo_level_get(const stmdev_ctx_t *ctx, uint8_t *val);
+#endif /* ILPS22QS_FIFO_EN */
 
 typedef struct
 {
@@ -683,19 +782,25 @@ typedef struct
   int32_t lsb; /* 24 bit properly right aligned */
   int32_t raw;
 } ilps22qs_fifo_data_t;
+#if (ILPS22QS_FIFO_EN != 0)
 int32_t ilps22qs_fifo_data_get(const stmdev_ctx_t *ctx, uint8_t samp,
                                ilps22qs_md_t *md, ilps22qs_fifo_data_t *data);
+#endif /* ILPS22QS_FIFO_EN */
 
 typedef struct
 {
   uint8_t int_latched  : 1; /* int events are: int on threshold, FIFO */
 } ilps22qs_int_mode_t;
+#if (ILPS22QS_INT_EN != 0)
 int32_t ilps22qs_interrupt_mode_set(const stmdev_ctx_t *ctx, ilps22qs_int_mode_t *val);
 int32_t ilps22qs_interrupt_mode_get(const stmdev_ctx_t *ctx, ilps22qs_int_mode_t *val);
+#endif /* ILPS22QS_INT_EN */
 
+#if (ILPS22QS_QVAR_EN != 0)
 int32_t ilps22qs_ah_qvar_disable(const stmdev_ctx_t *ctx);
 int32_t ilps22qs_ah_qvar_en_set(const stmdev_ctx_t *ctx, uint8_t val);
 int32_t ilps22qs_ah_qvar_en_get(const stmdev_ctx_t *ctx, uint8_t *val);
+#endif /* ILPS22QS_QVAR_EN */
 
 typedef struct
 {
@@ -705,10 +810,12 @@ typedef struct
   uint8_t over_th  : 1; /* Pressure data over threshold event */
   uint8_t under_th : 1; /* Pressure data under threshold event */
 } ilps22qs_int_th_md_t;
+#if (ILPS22QS_INT_EN != 0)
 int32_t ilps22qs_int_on_threshold_mode_set(const stmdev_ctx_t *ctx,
                                            ilps22qs_int_th_md_t *val);
 int32_t ilps22qs_int_on_threshold_mode_get(const stmdev_ctx_t *ctx,
                                            ilps22qs_int_th_md_t *val);
+#endif /* ILPS22QS_INT_EN */
 
 typedef enum
 {
@@ -722,6 +829,7 @@ typedef struct
   ilps22qs_apply_ref_t apply_ref;
   uint8_t get_ref : 1; /* Use current pressure value as reference */
 } ilps22qs_ref_md_t;
+#if (ILPS22QS_REF_EN != 0)
 int32_t ilps22qs_reference_mode_set(const stmdev_ctx_t *ctx,
                                     ilps22qs_ref_md_t *val);
 int32_t ilps22qs_reference_mode_get(const stmdev_ctx_t *ctx,
@@ -729,6 +837,7 @@ int32_t ilps22qs_reference_mode_get(const stmdev_ctx_t *ctx,
 
 int32_t ilps22qs_opc_set(const stmdev_ctx_t *ctx, int16_t val);
 int32_t ilps22qs_opc_get(const stmdev_ctx_t *ctx, int16_t *val);
+#endif /* ILPS22QS_REF_EN */
 
 /**
   *@}
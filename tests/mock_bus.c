@@ -0,0 +1,137 @@
+/**
+  ******************************************************************************
+  * @file    mock_bus.c
+  * @author  Sensors Software Solution Team
+  * @brief   RAM register image standing in for the sensor in host tests
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include <string.h>
+
+int test_failed;
+
+static uint8_t mock_bus_fifo_get(mock_bus_t *bus, uint8_t reg)
+{
+  uint8_t val;
+
+  switch (reg)
+  {
+    case ILPS22QS_FIFO_STATUS1:
+      val = bus->fifo_level;
+      break;
+    case ILPS22QS_FIFO_DATA_OUT_PRESS_XL:
+      bus->fifo_word = bus->fifo_gen(bus, bus->fifo_cnt);
+      bus->fifo_cnt++;
+      val = (uint8_t)bus->fifo_word;
+      break;
+    case ILPS22QS_FIFO_DATA_OUT_PRESS_L:
+      val = (uint8_t)(bus->fifo_word >> 8);
+      break;
+    case ILPS22QS_FIFO_DATA_OUT_PRESS_H:
+      val = (uint8_t)(bus->fifo_word >> 16);
+      break;
+    default:
+      val = bus->regs[reg];
+      break;
+  }
+
+  return val;
+}
+
+uint8_t mock_bus_get(mock_bus_t *bus, uint8_t reg)
+{
+  if (bus->on_read != NULL)
+  {
+    return bus->on_read(bus, reg);
+  }
+
+  return (bus->fifo_gen != NULL) ? mock_bus_fifo_get(bus, reg) :
+         bus->regs[reg];
+}
+
+void mock_bus_put(mock_bus_t *bus, uint8_t reg, uint8_t val)
+{
+  if (bus->on_write != NULL)
+  {
+    bus->on_write(bus, reg, val);
+  }
+  else
+  {
+    bus->regs[reg] = val;
+  }
+}
+
+static int32_t mock_bus_write(void *handle, uint8_t reg, const uint8_t *buf,
+                              uint16_t len)
+{
+  mock_bus_t *bus = (mock_bus_t *)handle;
+  uint16_t i;
+
+  bus->wr++;
+  bus->wr_bytes += len;
+  for (i = 0U; i < len; i++)
+  {
+    mock_bus_put(bus, (uint8_t)(reg + i), buf[i]);
+  }
+
+  return 0;
+}
+
+static int32_t mock_bus_read(void *handle, uint8_t reg, uint8_t *buf,
+                             uint16_t len)
+{
+  mock_bus_t *bus = (mock_bus_t *)handle;
+  uint16_t i;
+
+  bus->rd++;
+  bus->rd_bytes += len;
+  for (i = 0U; i < len; i++)
+  {
+    buf[i] = mock_bus_get(bus, (uint8_t)(reg + i));
+  }
+
+  return 0;
+}
+
+static void mock_bus_delay(uint32_t ms)
+{
+  (void)ms;
+}
+
+void mock_bus_init(mock_bus_t *bus, stmdev_ctx_t *ctx)
+{
+  (void)memset(bus, 0, sizeof(mock_bus_t));
+  bus->regs[ILPS22QS_WHO_AM_I] = ILPS22QS_ID;
+
+  (void)memset(ctx, 0, sizeof(stmdev_ctx_t));
+  ctx->write_reg = mock_bus_write;
+  ctx->read_reg = mock_bus_read;
+  ctx->mdelay = mock_bus_delay;
+  ctx->handle = bus;
+}
+
+void mock_bus_count_reset(mock_bus_t *bus)
+{
+  bus->rd = 0U;
+  bus->wr = 0U;
+  bus->rd_bytes = 0U;
+  bus->wr_bytes = 0U;
+}
+
+int test_report(const char *name)
+{
+  printf("%s: %s\n", name, (test_failed == 0) ? "PASS" : "FAIL");
+
+  return (test_failed == 0) ? 0 : 1;
+}
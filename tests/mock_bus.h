@@ -0,0 +1,68 @@
+/**
+  ******************************************************************************
+  * @file    mock_bus.h
+  * @author  Sensors Software Solution Team
+  * @brief   RAM register image standing in for the sensor in host tests
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#ifndef MOCK_BUS_H
+#define MOCK_BUS_H
+
+#include "ilps22qs_reg.h"
+#include <stdio.h>
+
+/*
+ * Registers are a 256-byte image with address auto-increment. on_read /
+ * on_write, when set, see every byte and can emulate status or FIFO
+ * registers; the transaction counters measure the bus load of a call.
+ * With fifo_gen set, FIFO_STATUS1 reports fifo_level and every read of
+ * FIFO_DATA_OUT_PRESS_XL pops the next 24-bit word from fifo_gen.
+ */
+typedef struct mock_bus_s mock_bus_t;
+struct mock_bus_s
+{
+  uint8_t regs[256];
+  uint32_t rd;                     /* read transactions */
+  uint32_t wr;                     /* write transactions */
+  uint32_t rd_bytes;
+  uint32_t wr_bytes;
+  uint8_t (*on_read)(mock_bus_t *bus, uint8_t reg);
+  void (*on_write)(mock_bus_t *bus, uint8_t reg, uint8_t val);
+  uint32_t (*fifo_gen)(mock_bus_t *bus, uint32_t idx);
+  uint32_t fifo_cnt;               /* words popped */
+  uint32_t fifo_word;
+  uint8_t fifo_level;
+  void *priv;
+};
+
+void mock_bus_init(mock_bus_t *bus, stmdev_ctx_t *ctx);
+uint8_t mock_bus_get(mock_bus_t *bus, uint8_t reg);
+void mock_bus_put(mock_bus_t *bus, uint8_t reg, uint8_t val);
+void mock_bus_count_reset(mock_bus_t *bus);
+
+extern int test_failed;
+
+#define TEST_CHECK(cond)                                              \
+  do                                                                  \
+  {                                                                   \
+    if (!(cond))                                                      \
+    {                                                                 \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+      test_failed++;                                                  \
+    }                                                                 \
+  } while (0)
+
+int test_report(const char *name);
+
+#endif /* MOCK_BUS_H */
@@ -0,0 +1,111 @@
+/**
+  ******************************************************************************
+  * @file    test_allan.c
+  * @author  Sensors Software Solution Team
+  * @brief   Allan deviation analyzer and settings sweep
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <math.h>
+#include <string.h>
+
+#define N 4096U
+
+static uint32_t seed = 11U;
+
+/* uniform white noise of +-a hPa: standard deviation a / sqrt(3) */
+static float_t noise(float_t a)
+{
+  seed = (seed * 1103515245U) + 12345U;
+
+  return a * (((float_t)((seed >> 8) & 0xFFFFU) / 32767.5f) - 1.0f);
+}
+
+/* 1000 hPa + 0.05 hPa white noise, 4096 LSB/hPa */
+static uint32_t fifo_gen(mock_bus_t *bus, uint32_t idx)
+{
+  (void)bus;
+  (void)idx;
+
+  return (uint32_t)((1000.0f + noise(0.05f)) * 4096.0f) & 0xFFFFFFU;
+}
+
+int main(void)
+{
+  static ilps22qs_allan_t allan, sw[2];
+  ilps22qs_fifo_data_t data[64];
+  mock_bus_t bus;
+  stmdev_ctx_t ctx;
+  ilps22qs_md_t md[2], md10;
+  float_t sigma = 1.0f / sqrtf(3.0f), tau, adev;
+  uint16_t i, k;
+
+  /* white noise: adev(tau) = sigma / sqrt(tau in samples) */
+  TEST_CHECK(ilps22qs_allan_init(&allan) == 0);
+  for (k = 0U; k < (N / 64U); k++)
+  {
+    for (i = 0U; i < 64U; i++)
+    {
+      data[i].hpa = 1000.0f + noise(1.0f);
+    }
+    TEST_CHECK(ilps22qs_allan_add(&allan, data, 64U) == 0);
+  }
+  (void)memset(&md10, 0, sizeof(md10));
+  md10.odr = ILPS22QS_10Hz;
+  TEST_CHECK(ilps22qs_allan_dev_get(&allan, 0U, &md10, &tau, &adev) == 0);
+  TEST_CHECK(fabsf(tau - 0.1f) < 1e-6f);
+  TEST_CHECK(fabsf(adev - sigma) < (0.1f * sigma));
+  TEST_CHECK(ilps22qs_allan_dev_get(&allan, 4U, &md10, &tau, &adev) == 0);
+  TEST_CHECK(fabsf(tau - 1.6f) < 1e-5f);
+  TEST_CHECK(fabsf(adev - (sigma / 4.0f)) < (0.3f * sigma / 4.0f));
+
+  /* interleaved: pressure samples are 0.2 s apart */
+  md10.interleaved_mode = 1U;
+  TEST_CHECK(ilps22qs_allan_dev_get(&allan, 4U, &md10, &tau, &adev) == 0);
+  TEST_CHECK(fabsf(tau - 3.2f) < 1e-5f);
+  md10.interleaved_mode = 0U;
+
+  /* the floor of white noise is at the longest reported tau */
+  TEST_CHECK(ilps22qs_allan_floor_get(&allan, &md10, &tau, &adev) == 0);
+  TEST_CHECK(tau > 1.6f);
+  TEST_CHECK(ilps22qs_allan_dev_get(&allan, (uint8_t)(ILPS22QS_ALLAN_LEVELS -
+                                                      1U), &md10, &tau,
+                                    &adev) == -1);
+
+  /* sweep two settings on the mock FIFO: 0.05 hPa noise at tau = 1 */
+  mock_bus_init(&bus, &ctx);
+  bus.fifo_gen = fifo_gen;
+  bus.fifo_level = 32U;
+  (void)memset(md, 0, sizeof(md));
+  md[0].odr = ILPS22QS_25Hz;
+  md[0].avg = ILPS22QS_16_AVG;
+  md[1].odr = ILPS22QS_10Hz;
+  md[1].avg = ILPS22QS_64_AVG;
+  TEST_CHECK(ilps22qs_allan_sweep(&ctx, md, 2U, 1024U, sw) == 0);
+  TEST_CHECK(bus.fifo_cnt == (2U * (1024U + 32U)));
+  for (i = 0U; i < 2U; i++)
+  {
+    TEST_CHECK(ilps22qs_allan_dev_get(&sw[i], 0U, &md[i], &tau,
+                                      &adev) == 0);
+    TEST_CHECK(fabsf(adev - (0.05f * sigma)) < (0.01f * sigma));
+  }
+  TEST_CHECK((bus.regs[ILPS22QS_CTRL_REG1] >> 3) == (uint8_t)ILPS22QS_10Hz);
+
+  /* a stopped sensor times out */
+  bus.fifo_level = 0U;
+  TEST_CHECK(ilps22qs_allan_sweep(&ctx, md, 1U, 16U, sw) != 0);
+
+  return test_report("allan");
+}
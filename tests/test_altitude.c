@@ -0,0 +1,64 @@
+/**
+  ******************************************************************************
+  * @file    test_altitude.c
+  * @author  Sensors Software Solution Team
+  * @brief   altitude conversion, exact and fast
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <math.h>
+#include <string.h>
+
+int main(void)
+{
+  ilps22qs_fifo_data_t data[3];
+  float_t alt[3], hpa, qnh, err, err_max = 0.0f;
+
+  /* standard atmosphere: 0 m at QNH, 988.5 m at 900 hPa */
+  TEST_CHECK(fabsf(ilps22qs_from_hPa_to_m(ILPS22QS_QNH_STD_hPa,
+                                          ILPS22QS_QNH_STD_hPa)) < 1e-3f);
+  TEST_CHECK(fabsf(ilps22qs_from_hPa_to_m(900.0f, ILPS22QS_QNH_STD_hPa) -
+                   988.5f) < 0.5f);
+
+  /* fast approximation within 0.1 m over the sensor range */
+  for (qnh = 950.0f; qnh <= 1050.0f; qnh += 25.0f)
+  {
+    for (hpa = 260.0f; hpa <= 1260.0f; hpa += 0.5f)
+    {
+      err = fabsf(ilps22qs_from_hPa_to_m_fast(hpa, qnh) -
+                  ilps22qs_from_hPa_to_m(hpa, qnh));
+      err_max = (err > err_max) ? err : err_max;
+    }
+  }
+  printf("altitude: fast max error %.3f m\n", (double)err_max);
+  TEST_CHECK(err_max < 0.1f);
+
+  /* batch: AH_QVAR samples (hpa 0) give 0 m */
+  (void)memset(data, 0, sizeof(data));
+  data[0].hpa = 1000.0f;
+  data[2].hpa = 800.0f;
+  TEST_CHECK(ilps22qs_altitude_get(data, 3U, ILPS22QS_QNH_STD_hPa,
+                                   ILPS22QS_ALT_FAST, alt) == 0);
+  TEST_CHECK((alt[0] > 100.0f) && (alt[0] < 120.0f));
+  TEST_CHECK(alt[1] == 0.0f);
+  TEST_CHECK(alt[2] > alt[0]);
+
+  TEST_CHECK(ilps22qs_altitude_get(data, 3U, 0.0f, ILPS22QS_ALT_EXACT,
+                                   alt) == -1);
+  TEST_CHECK(ilps22qs_altitude_get(NULL, 3U, ILPS22QS_QNH_STD_hPa,
+                                   ILPS22QS_ALT_EXACT, alt) == -1);
+
+  return test_report("altitude");
+}
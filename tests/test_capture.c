@@ -0,0 +1,144 @@
+/**
+  ******************************************************************************
+  * @file    test_capture.c
+  * @author  Sensors Software Solution Team
+  * @brief   pre/post-trigger event capture on the FIFO
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <math.h>
+#include <string.h>
+
+static mock_bus_t bus;
+
+/* 0.0625 hPa steps from 1000 hPa, 2 hPa jump at sample 15 */
+static float_t capture_hpa(uint32_t idx)
+{
+  float_t hpa = 1000.0f + (0.0625f * (float_t)idx);
+
+  return (idx < 15U) ? hpa : (hpa + 2.0f);
+}
+
+static uint32_t capture_gen(mock_bus_t *b, uint32_t idx)
+{
+  b->fifo_level--;
+
+  return (uint32_t)(capture_hpa(idx) * 4096.0f);
+}
+
+/* interleaved: odd slots are AH_QVAR (bit 0 of the word set) */
+static uint32_t capture_gen_il(mock_bus_t *b, uint32_t idx)
+{
+  b->fifo_level--;
+
+  return ((idx & 1U) != 0U) ? 0x000101U :
+         ((uint32_t)(capture_hpa(idx) * 4096.0f) & ~1U);
+}
+
+/* reference captured by AUTOREFP, hPa * 16 */
+static void ref_set(float_t hpa)
+{
+  uint16_t ref = (uint16_t)(hpa * 16.0f);
+
+  bus.regs[ILPS22QS_REF_P_L] = (uint8_t)ref;
+  bus.regs[ILPS22QS_REF_P_H] = (uint8_t)(ref >> 8);
+}
+
+/* the post-trigger samples arrive four at a time while the host waits */
+static void capture_delay(uint32_t ms)
+{
+  (void)ms;
+  bus.fifo_level = 4U;
+}
+
+int main(void)
+{
+  stmdev_ctx_t ctx;
+  ilps22qs_md_t md;
+  ilps22qs_capt_t capt;
+  ilps22qs_capt_rec_t rec;
+  ilps22qs_fifo_data_t data[20];
+  uint32_t word = 1000U * 4096U;
+  uint8_t i;
+  int32_t ok = 1;
+
+  mock_bus_init(&bus, &ctx);
+  ctx.mdelay = capture_delay;
+  (void)memset(&md, 0, sizeof(md));
+  md.odr = ILPS22QS_10Hz;
+  md.fs = ILPS22QS_1260hPa;
+  rec.data = data;
+
+  /* reference at 1000 hPa */
+  bus.regs[ILPS22QS_PRESS_OUT_XL] = (uint8_t)word;
+  bus.regs[ILPS22QS_PRESS_OUT_L] = (uint8_t)(word >> 8);
+  bus.regs[ILPS22QS_PRESS_OUT_H] = (uint8_t)(word >> 16);
+
+  TEST_CHECK(ilps22qs_capt_arm(&ctx, &md, 1.0f, 0U, 8U, &capt) == -1);
+  TEST_CHECK(ilps22qs_capt_arm(&ctx, &md, 1.0f, 200U, 100U, &capt) == -1);
+
+  /* continuous STREAM over the whole FIFO */
+  TEST_CHECK(ilps22qs_capt_arm(&ctx, &md, 1.0f, 8U, 12U, &capt) == 0);
+  TEST_CHECK((bus.regs[ILPS22QS_FIFO_CTRL] & 0x0FU) == 0x02U);
+  bus.fifo_gen = capture_gen;
+  ref_set(1000.0f);
+
+  /* no threshold event: empty record, nothing read from the FIFO */
+  TEST_CHECK(ilps22qs_capt_event(&ctx, &capt, 100U, &rec) == 0);
+  TEST_CHECK(((rec.pre + rec.post) == 0U) && (bus.fifo_cnt == 0U));
+
+  /* event polled 4 samples late: 8 samples up to the trigger, 12 after */
+  bus.regs[ILPS22QS_INT_SOURCE] = 0x04U;
+  bus.fifo_level = 20U;
+  TEST_CHECK(ilps22qs_capt_event(&ctx, &capt, 200U, &rec) == 0);
+  TEST_CHECK((rec.t == 200U) && (rec.pre == 8U) && (rec.post == 12U) &&
+             (rec.lag == 4U));
+  TEST_CHECK(fabsf(rec.period_s - 0.1f) < 1e-6f);
+  for (i = 0U; i < 20U; i++)
+  {
+    ok &= (fabsf(data[i].hpa - capture_hpa(8U + i)) < 1e-3f) ? 1 : 0;
+  }
+  TEST_CHECK(ok != 0);
+  TEST_CHECK((capt.captures == 1U) &&
+             (fabsf(capt.woc.ref_hpa - capture_hpa(27U)) < 1e-3f));
+  TEST_CHECK((bus.regs[ILPS22QS_FIFO_CTRL] & 0x07U) == 0x02U);
+
+  /* polled too late: the oldest sample of a full FIFO is already out */
+  ref_set(990.0f);
+  bus.fifo_level = 128U;
+  TEST_CHECK(ilps22qs_capt_event(&ctx, &capt, 300U, &rec) == -1);
+  TEST_CHECK((rec.post == 0U) && (capt.captures == 1U));
+
+  /* interleaved, last sample AH_QVAR: re-armed on the last pressure one */
+  md.interleaved_mode = 1U;
+  TEST_CHECK(ilps22qs_capt_arm(&ctx, &md, 1.0f, 2U, 3U, &capt) == 0);
+  bus.fifo_gen = capture_gen_il;
+  bus.fifo_cnt = 0U;
+  bus.fifo_level = 17U;
+  bus.regs[ILPS22QS_INT_SOURCE] = 0x04U;
+  ref_set(1000.0f);
+  TEST_CHECK(ilps22qs_capt_event(&ctx, &capt, 400U, &rec) == 0);
+  TEST_CHECK((rec.pre == 2U) && (rec.post == 3U) && (rec.lag == 0U));
+  TEST_CHECK((data[0].hpa == 0.0f) && (data[4].hpa == 0.0f));
+  TEST_CHECK(fabsf(data[1].hpa - capture_hpa(16U)) < 1e-3f);
+  TEST_CHECK((capt.captures == 1U) &&
+             (fabsf(capt.woc.ref_hpa - capture_hpa(18U)) < 1e-3f));
+
+  TEST_CHECK(ilps22qs_capt_disarm(&ctx) == 0);
+  TEST_CHECK((bus.regs[ILPS22QS_FIFO_CTRL] & 0x07U) == 0U);
+  TEST_CHECK((bus.regs[ILPS22QS_INTERRUPT_CFG] & 0x03U) == 0U);
+
+  return test_report("capture");
+}
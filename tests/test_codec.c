@@ -0,0 +1,116 @@
+/**
+  ******************************************************************************
+  * @file    test_codec.c
+  * @author  Sensors Software Solution Team
+  * @brief   FIFO word codec round-trip and frame size
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <string.h>
+
+#define N 255U
+
+static ilps22qs_fifo_data_t in[N], out[N];
+static uint8_t frame[ILPS22QS_CODEC_SIZE_MAX(N)];
+static uint32_t seed = 1U;
+
+static int32_t noise(int32_t amp)
+{
+  seed = (seed * 1103515245U) + 12345U;
+
+  return (int32_t)((seed >> 16) % (uint32_t)((2 * amp) + 1)) - amp;
+}
+
+/* encode, decode and compare the raw words; returns the frame length */
+static uint16_t round_trip(uint8_t interleaved)
+{
+  ilps22qs_md_t md;
+  uint16_t len = 0U, used = 0U;
+  uint8_t num = 0U;
+  uint16_t i;
+
+  (void)memset(&md, 0, sizeof(md));
+  md.fs = ILPS22QS_1260hPa;
+  md.interleaved_mode = interleaved;
+  TEST_CHECK(ilps22qs_codec_encode(in, (uint8_t)N, interleaved, frame,
+                                   (uint16_t)sizeof(frame), &len) == 0);
+  TEST_CHECK(ilps22qs_codec_decode(frame, len, &md, out, &num, &used) == 0);
+  TEST_CHECK((num == N) && (used == len));
+  for (i = 0U; i < N; i++)
+  {
+    TEST_CHECK(out[i].raw == in[i].raw);
+  }
+
+  return len;
+}
+
+int main(void)
+{
+  uint32_t word;
+  uint16_t len, i;
+
+  /* 1013 hPa random walk of +-8 LSB per sample, 4096 LSB/hPa */
+  (void)memset(in, 0, sizeof(in));
+  word = 1013U * 4096U;
+  for (i = 0U; i < N; i++)
+  {
+    word = (uint32_t)((int32_t)word + noise(8));
+    in[i].raw = (int32_t)(word << 8);
+  }
+  len = round_trip(0U);
+  printf("codec: random walk %.1f bits/sample\n", (8.0 * len) / N);
+  TEST_CHECK(len < ((N * 3U) / 4U));
+
+  /* interleaved: AH_QVAR words (tag bit 0 set) on every other slot */
+  for (i = 0U; i < N; i++)
+  {
+    word = ((i & 1U) != 0U) ? (((uint32_t)(1000 + noise(8)) << 1) | 1U) :
+           ((uint32_t)in[i].raw >> 8) & ~1U;
+    in[i].raw = (int32_t)(word << 8);
+  }
+  len = round_trip(1U);
+  printf("codec: interleaved %.1f bits/sample\n", (8.0 * len) / N);
+
+  /* a linear ramp: delta-of-delta residuals are 0 after the first one */
+  for (i = 0U; i < N; i++)
+  {
+    in[i].raw = (int32_t)(((1013U * 4096U) + (i * 5U)) << 8);
+  }
+  len = round_trip(0U);
+  TEST_CHECK(len < ((N * 5U) / 8U));
+
+  /* worst case: full-range words still fit the bound */
+  for (i = 0U; i < N; i++)
+  {
+    in[i].raw = (int32_t)((((i & 1U) != 0U) ? 0xFFFFFFU : 0U) << 8);
+  }
+  len = round_trip(0U);
+  TEST_CHECK(len <= ILPS22QS_CODEC_SIZE_MAX(N));
+
+  /* truncated frame and short output buffer are rejected */
+  {
+    ilps22qs_md_t md;
+    uint16_t used;
+    uint8_t num;
+
+    (void)memset(&md, 0, sizeof(md));
+    TEST_CHECK(ilps22qs_codec_decode(frame, (uint16_t)(len - 1U), &md, out,
+                                     &num, &used) == -1);
+    TEST_CHECK(ilps22qs_codec_encode(in, (uint8_t)N, 0U, frame, 16U,
+                                     &len) == -1);
+  }
+
+  return test_report("codec");
+}
@@ -0,0 +1,131 @@
+/**
+  ******************************************************************************
+  * @file    test_diff.c
+  * @author  Sensors Software Solution Team
+  * @brief   time-aligned differential pressure
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <math.h>
+#include <string.h>
+
+/* 20 samples at 10 Hz of a 0.1 hPa/s ramp, starting at t0_ms */
+static void diff_batch(ilps22qs_fifo_data_t *data, uint32_t t0_ms,
+                       float_t base)
+{
+  uint16_t i;
+
+  (void)memset(data, 0, 20U * sizeof(ilps22qs_fifo_data_t));
+  for (i = 0U; i < 20U; i++)
+  {
+    data[i].hpa = base + (0.1f * (((float_t)t0_ms / 1000.0f) +
+                                  ((float_t)i * 0.1f)));
+  }
+}
+
+int main(void)
+{
+  ilps22qs_diff_t pair;
+  ilps22qs_diff_data_t out[40];
+  ilps22qs_fifo_data_t data[20];
+  uint16_t num, i;
+  int32_t ok = 1;
+
+  TEST_CHECK(ilps22qs_diff_init(&pair, 0.0f) == -1);
+  TEST_CHECK(ilps22qs_diff_init(&pair, 0.1f) == 0);
+
+  /* b is sampled 50 ms after a and reads 0.5 hPa less */
+  diff_batch(data, 1000U, 1000.0f);
+  TEST_CHECK(ilps22qs_diff_push(&pair, 0U, 1000U, 0.1f, data, 20U) == 0);
+  TEST_CHECK(ilps22qs_diff_get(&pair, out, 40U, &num) == 0);
+  TEST_CHECK(num == 0U);
+  diff_batch(data, 1050U, 999.5f);
+  TEST_CHECK(ilps22qs_diff_push(&pair, 1U, 1050U, 0.1f, data, 20U) == 0);
+  TEST_CHECK(ilps22qs_diff_push(&pair, 2U, 1050U, 0.1f, data, 20U) == -1);
+  /* the same batch again, or an older one, is refused */
+  TEST_CHECK(ilps22qs_diff_push(&pair, 1U, 1050U, 0.1f, data, 20U) == -1);
+  TEST_CHECK(ilps22qs_diff_push(&pair, 1U, 2900U, 0.1f, data, 20U) == -1);
+  TEST_CHECK(pair.ch[1].cnt == 20U);
+
+  /* grid from 1050 ms to the last point covered by a */
+  TEST_CHECK(ilps22qs_diff_get(&pair, out, 40U, &num) == 0);
+  TEST_CHECK(num == 19U);
+  for (i = 0U; i < num; i++)
+  {
+    ok &= (fabsf(out[i].dp_hpa - 0.5f) < 1e-3f) ? 1 : 0;
+    ok &= (out[i].t_ms == (1050U + (100U * i))) ? 1 : 0;
+  }
+  TEST_CHECK(ok != 0);
+
+  /* zero offset over the next 5 points */
+  TEST_CHECK(ilps22qs_diff_zero(&pair, 5U) == 0);
+  diff_batch(data, 3000U, 1000.0f);
+  TEST_CHECK(ilps22qs_diff_push(&pair, 0U, 3000U, 0.1f, data, 20U) == 0);
+  diff_batch(data, 3050U, 999.5f);
+  TEST_CHECK(ilps22qs_diff_push(&pair, 1U, 3050U, 0.1f, data, 20U) == 0);
+  TEST_CHECK(ilps22qs_diff_get(&pair, out, 40U, &num) == 0);
+  TEST_CHECK((num == 20U) && (fabsf(pair.offset - 0.5f) < 1e-3f));
+  TEST_CHECK(fabsf(out[num - 1U].dp_hpa) < 1e-3f);
+
+  /* a lost batch of a: no output across the gap, then the grid resumes */
+  TEST_CHECK(ilps22qs_diff_init(&pair, 0.1f) == 0);
+  diff_batch(data, 1000U, 1000.0f);
+  TEST_CHECK(ilps22qs_diff_push(&pair, 0U, 1000U, 0.1f, data, 20U) == 0);
+  diff_batch(data, 4000U, 1000.0f);
+  TEST_CHECK(ilps22qs_diff_push(&pair, 0U, 4000U, 0.1f, data, 20U) == 0);
+  for (i = 0U; i < 3U; i++)
+  {
+    diff_batch(data, 1050U + (2000U * i), 999.5f);
+    TEST_CHECK(ilps22qs_diff_push(&pair, 1U, 1050U + (2000U * i), 0.1f, data,
+                                  20U) == 0);
+  }
+  TEST_CHECK(ilps22qs_diff_get(&pair, out, 40U, &num) == 0);
+  TEST_CHECK(num == 38U);
+  ok = 1;
+  for (i = 0U; i < num; i++)
+  {
+    ok &= (fabsf(out[i].dp_hpa - 0.5f) < 1e-3f) ? 1 : 0;
+    ok &= ((out[i].t_ms < 2900U) || (out[i].t_ms > 4000U)) ? 1 : 0;
+  }
+  TEST_CHECK(ok != 0);
+
+  /* 70 ms grid: output times are rounded to the nearest ms */
+  TEST_CHECK(ilps22qs_diff_init(&pair, 0.07f) == 0);
+  diff_batch(data, 0U, 1000.0f);
+  TEST_CHECK(ilps22qs_diff_push(&pair, 0U, 1000U, 0.07f, data, 20U) == 0);
+  TEST_CHECK(ilps22qs_diff_push(&pair, 1U, 1000U, 0.07f, data, 20U) == 0);
+  TEST_CHECK(ilps22qs_diff_get(&pair, out, 40U, &num) == 0);
+  TEST_CHECK(num == 19U);
+  ok = 1;
+  for (i = 0U; i < num; i++)
+  {
+    ok &= (out[i].t_ms == (1000U + (70U * i))) ? 1 : 0;
+  }
+  TEST_CHECK(ok != 0);
+
+  /* a batch that does not fit is not queued at all */
+  TEST_CHECK(ilps22qs_diff_init(&pair, 0.1f) == 0);
+  for (i = 0U; i < (ILPS22QS_DIFF_BUF_N / 20U); i++)
+  {
+    diff_batch(data, 2000U * i, 1000.0f);
+    TEST_CHECK(ilps22qs_diff_push(&pair, 0U, 2000U * i, 0.1f, data,
+                                  20U) == 0);
+  }
+  TEST_CHECK(ilps22qs_diff_push(&pair, 0U, 2000U * i, 0.1f, data, 20U) == -1);
+  TEST_CHECK(pair.ch[0].cnt == (20U * (ILPS22QS_DIFF_BUF_N / 20U)));
+  TEST_CHECK(ilps22qs_diff_push(&pair, 1U, 0U, 0.0f, data, 20U) == -1);
+
+  return test_report("diff");
+}
@@ -0,0 +1,47 @@
+/**
+  ******************************************************************************
+  * @file    test_fifo.c
+  * @author  Sensors Software Solution Team
+  * @brief   FIFO configuration setters
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include <string.h>
+
+int main(void)
+{
+  mock_bus_t bus;
+  stmdev_ctx_t ctx;
+  ilps22qs_fifo_event_t ev;
+  uint8_t wtm = 0U;
+
+  mock_bus_init(&bus, &ctx);
+
+  /* STOP_ON_WTM (FIFO_CTRL bit 3) follows the requested event */
+  ev = ILPS22QS_FIFO_EV_WTM;
+  TEST_CHECK(ilps22qs_fifo_stop_on_wtm_set(&ctx, &ev) == 0);
+  TEST_CHECK((bus.regs[ILPS22QS_FIFO_CTRL] & 0x08U) != 0U);
+  ev = ILPS22QS_FIFO_EV_FULL;
+  TEST_CHECK(ilps22qs_fifo_stop_on_wtm_get(&ctx, &ev) == 0);
+  TEST_CHECK(ev == ILPS22QS_FIFO_EV_WTM);
+  ev = ILPS22QS_FIFO_EV_FULL;
+  TEST_CHECK(ilps22qs_fifo_stop_on_wtm_set(&ctx, &ev) == 0);
+  TEST_CHECK((bus.regs[ILPS22QS_FIFO_CTRL] & 0x08U) == 0U);
+
+  TEST_CHECK(ilps22qs_fifo_watermark_set(&ctx, 20U) == 0);
+  TEST_CHECK(ilps22qs_fifo_watermark_get(&ctx, &wtm) == 0);
+  TEST_CHECK(wtm == 20U);
+
+  return test_report("fifo");
+}
@@ -0,0 +1,96 @@
+/**
+  ******************************************************************************
+  * @file    test_filter.c
+  * @author  Sensors Software Solution Team
+  * @brief   host-side filter pipeline
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <math.h>
+#include <string.h>
+
+#define N 200U
+
+static ilps22qs_fifo_data_t data[N];
+
+int main(void)
+{
+  ilps22qs_filt_t filt;
+  ilps22qs_md_t md;
+  float_t var_in = 0.0f, var_out = 0.0f, d;
+  uint32_t seed = 1U;
+  uint16_t i;
+
+  /* biquad, 1 Hz at 25 Hz: unit DC gain, Nyquist tone removed */
+  (void)memset(&md, 0, sizeof(md));
+  md.odr = ILPS22QS_25Hz;
+  TEST_CHECK(ilps22qs_filt_init(&filt) == 0);
+  TEST_CHECK(ilps22qs_filt_biquad_add(&filt, &md, 1.0f) == 0);
+  TEST_CHECK(ilps22qs_filt_biquad_add(&filt, &md, 12.5f) == -1);
+  /* interleaved: pressure at 12.5 Hz, the cut-off must stay below 6.25 Hz */
+  md.interleaved_mode = 1U;
+  TEST_CHECK(ilps22qs_filt_biquad_add(&filt, &md, 6.25f) == -1);
+  TEST_CHECK(filt.num == 1U);
+  md.interleaved_mode = 0U;
+  for (i = 0U; i < N; i++)
+  {
+    data[i].hpa = 1000.0f + (((i & 1U) != 0U) ? 0.5f : -0.5f);
+  }
+  TEST_CHECK(ilps22qs_filt_apply(&filt, data, (uint16_t)N) == 0);
+  TEST_CHECK(fabsf(data[N - 1U].hpa - 1000.0f) < 0.01f);
+
+  /* moving average of 2 over the same tone, AH_QVAR samples untouched */
+  TEST_CHECK(ilps22qs_filt_init(&filt) == 0);
+  TEST_CHECK(ilps22qs_filt_mov_avg_add(&filt, 2U) == 0);
+  TEST_CHECK(ilps22qs_filt_mov_avg_add(&filt, 0U) == -1);
+  for (i = 0U; i < N; i++)
+  {
+    data[i].hpa = 1000.0f + (((i & 1U) != 0U) ? 0.5f : -0.5f);
+  }
+  data[10].hpa = 0.0f;
+  TEST_CHECK(ilps22qs_filt_apply(&filt, data, 10U) == 0);
+  TEST_CHECK(fabsf(data[9].hpa - 1000.0f) < 1e-3f);
+  TEST_CHECK(ilps22qs_filt_apply(&filt, &data[10], 1U) == 0);
+  TEST_CHECK(data[10].hpa == 0.0f);
+
+  /* Kalman on white noise: variance goes down */
+  TEST_CHECK(ilps22qs_filt_init(&filt) == 0);
+  TEST_CHECK(ilps22qs_filt_kalman_add(&filt, 1e-5f, 1e-2f) == 0);
+  for (i = 0U; i < N; i++)
+  {
+    seed = (seed * 1103515245U) + 12345U;
+    data[i].hpa = 1000.0f + (((float_t)((seed >> 16) & 0xFFU) - 127.5f) /
+                             1280.0f);
+    d = data[i].hpa - 1000.0f;
+    var_in += (i >= (N / 2U)) ? (d * d) : 0.0f;
+  }
+  TEST_CHECK(ilps22qs_filt_apply(&filt, data, (uint16_t)N) == 0);
+  for (i = (uint16_t)(N / 2U); i < N; i++)
+  {
+    d = data[i].hpa - 1000.0f;
+    var_out += d * d;
+  }
+  TEST_CHECK(var_out < (0.25f * var_in));
+
+  /* stage count limit */
+  TEST_CHECK(ilps22qs_filt_init(&filt) == 0);
+  for (i = 0U; i < ILPS22QS_FILT_STAGES_MAX; i++)
+  {
+    TEST_CHECK(ilps22qs_filt_mov_avg_add(&filt, 4U) == 0);
+  }
+  TEST_CHECK(ilps22qs_filt_mov_avg_add(&filt, 4U) == -1);
+
+  return test_report("filter");
+}
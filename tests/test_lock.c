@@ -0,0 +1,149 @@
+/**
+  ******************************************************************************
+  * @file    test_lock.c
+  * @author  Sensors Software Solution Team
+  * @brief   register group lock hooks around read-modify-write setters
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include <string.h>
+
+static uint8_t held[ILPS22QS_LOCK_GRP_NUM];
+static uint32_t locks;
+static uint32_t unlocked_writes;
+static uint32_t locked_delays;
+static mock_bus_t bus;
+
+/* overrides the __weak hooks of the driver */
+void ilps22qs_lock(const stmdev_ctx_t *ctx, ilps22qs_lock_grp_t grp)
+{
+  (void)ctx;
+  TEST_CHECK(held[grp] == 0U);
+  held[grp] = 1U;
+  locks++;
+}
+
+void ilps22qs_unlock(const stmdev_ctx_t *ctx, ilps22qs_lock_grp_t grp)
+{
+  (void)ctx;
+  TEST_CHECK(held[grp] == 1U);
+  held[grp] = 0U;
+}
+
+static int32_t grp_of(uint8_t reg)
+{
+  int32_t grp;
+
+  switch (reg)
+  {
+    case ILPS22QS_CTRL_REG1:
+    case ILPS22QS_CTRL_REG2:
+    case ILPS22QS_CTRL_REG3:
+      grp = (int32_t)ILPS22QS_LOCK_CTRL;
+      break;
+    case ILPS22QS_FIFO_CTRL:
+    case ILPS22QS_FIFO_WTM:
+      grp = (int32_t)ILPS22QS_LOCK_FIFO;
+      break;
+    case ILPS22QS_INTERRUPT_CFG:
+    case ILPS22QS_THS_P_L:
+    case ILPS22QS_THS_P_H:
+      grp = (int32_t)ILPS22QS_LOCK_INT;
+      break;
+    case ILPS22QS_IF_CTRL:
+    case ILPS22QS_I3C_IF_CTRL:
+      grp = (int32_t)ILPS22QS_LOCK_IF;
+      break;
+    default:
+      grp = -1;
+      break;
+  }
+
+  return grp;
+}
+
+/* every write to a group register must happen under its lock */
+static void on_write(mock_bus_t *bus, uint8_t reg, uint8_t val)
+{
+  int32_t grp = grp_of(reg);
+
+  if ((grp >= 0) && (held[grp] == 0U))
+  {
+    unlocked_writes++;
+  }
+  bus->regs[reg] = val;
+}
+
+static uint8_t none_held(void)
+{
+  uint8_t i, n = 0U;
+
+  for (i = 0U; i < ILPS22QS_LOCK_GRP_NUM; i++)
+  {
+    n = (uint8_t)(n + held[i]);
+  }
+
+  return (uint8_t)(n == 0U);
+}
+
+/* boot ends after the first delay, which must not be taken under a lock */
+static void mdelay(uint32_t ms)
+{
+  (void)ms;
+  locked_delays += (none_held() == 0U) ? 1U : 0U;
+  bus.regs[ILPS22QS_INT_SOURCE] = 0x00U;
+}
+
+int main(void)
+{
+  stmdev_ctx_t ctx;
+  ilps22qs_md_t md;
+  ilps22qs_data_t data;
+  ilps22qs_bus_mode_t bus_mode;
+  ilps22qs_int_th_md_t th;
+
+  mock_bus_init(&bus, &ctx);
+  bus.on_write = on_write;
+  (void)memset(&md, 0, sizeof(md));
+  (void)memset(&bus_mode, 0, sizeof(bus_mode));
+  (void)memset(&th, 0, sizeof(th));
+  md.odr = ILPS22QS_25Hz;
+  th.threshold = 100U;
+
+  TEST_CHECK(ilps22qs_init_set(&ctx, ILPS22QS_DRV_RDY) == 0);
+  TEST_CHECK(ilps22qs_bus_mode_set(&ctx, &bus_mode) == 0);
+  TEST_CHECK(ilps22qs_mode_set(&ctx, &md) == 0);
+  md.interleaved_mode = 1U;
+  TEST_CHECK(ilps22qs_mode_set(&ctx, &md) == 0);
+  TEST_CHECK(ilps22qs_fifo_mode_set(&ctx, ILPS22QS_STREAM) == 0);
+  TEST_CHECK(ilps22qs_fifo_watermark_set(&ctx, 16U) == 0);
+  TEST_CHECK(ilps22qs_int_on_threshold_mode_set(&ctx, &th) == 0);
+  TEST_CHECK(unlocked_writes == 0U);
+  TEST_CHECK(none_held() == 1U);
+
+  /* boot polling runs with the lock released */
+  ctx.mdelay = mdelay;
+  bus.regs[ILPS22QS_INT_SOURCE] = 0x80U;
+  TEST_CHECK(ilps22qs_init_set(&ctx, ILPS22QS_BOOT) == 0);
+  TEST_CHECK(bus.regs[ILPS22QS_INT_SOURCE] == 0x00U);
+  TEST_CHECK(locked_delays == 0U);
+  TEST_CHECK(none_held() == 1U);
+
+  /* data reads take no lock */
+  locks = 0U;
+  TEST_CHECK(ilps22qs_data_get(&ctx, &md, &data) == 0);
+  TEST_CHECK(locks == 0U);
+
+  return test_report("lock");
+}
@@ -0,0 +1,116 @@
+/**
+  ******************************************************************************
+  * @file    test_log.c
+  * @author  Sensors Software Solution Team
+  * @brief   sample log block writer
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <string.h>
+
+#define BLOCKS 8U
+
+static uint8_t image[BLOCKS][ILPS22QS_LOG_BLOCK_SIZE];
+static uint32_t blocks;
+static uint8_t fail;
+static ilps22qs_fifo_data_t data[400];
+
+static int32_t flush(void *handle, const uint8_t *block, uint16_t len)
+{
+  (void)handle;
+  if ((fail != 0U) || (blocks >= BLOCKS) || (len != ILPS22QS_LOG_BLOCK_SIZE))
+  {
+    return -1;
+  }
+  (void)memcpy(image[blocks], block, len);
+  blocks++;
+
+  return 0;
+}
+
+int main(void)
+{
+  static ilps22qs_log_t log;
+  ilps22qs_log_hdr_t hdr;
+  const uint8_t *rec;
+  uint32_t word;
+  uint16_t i;
+
+  (void)memset(data, 0, sizeof(data));
+  for (i = 0U; i < 400U; i++)
+  {
+    data[i].raw = (int32_t)(((1013U * 4096U) + i) << 8);
+  }
+
+  /* 400 samples at t = 1000 + 40 * i, then a batch after a gap */
+  TEST_CHECK(ilps22qs_log_init(&log, 7U, 40U, flush, NULL) == 0);
+  TEST_CHECK(ilps22qs_log_append(&log, 1000U, data, 250U) == 0);
+  TEST_CHECK(ilps22qs_log_append(&log, 1000U + (250U * 40U), &data[250],
+                                 150U) == 0);
+  TEST_CHECK(blocks == 2U);
+  TEST_CHECK(ilps22qs_log_append(&log, 50000U, data, 10U) == 0);
+  TEST_CHECK(blocks == 3U);
+  TEST_CHECK(ilps22qs_log_flush(&log) == 0);
+  TEST_CHECK(blocks == 4U);
+
+  TEST_CHECK(ilps22qs_log_block_check(image[0], &hdr) == 0);
+  TEST_CHECK((hdr.dev_id == 7U) && (hdr.seq == 0U) && (hdr.t0 == 1000U));
+  TEST_CHECK((hdr.dt == 40U) && (hdr.cnt == ILPS22QS_LOG_SAMPLES));
+  TEST_CHECK(ilps22qs_log_block_check(image[2], &hdr) == 0);
+  TEST_CHECK((hdr.seq == 2U) &&
+             (hdr.cnt == (400U - (2U * ILPS22QS_LOG_SAMPLES))));
+  TEST_CHECK(hdr.t0 == (1000U + (2U * ILPS22QS_LOG_SAMPLES * 40U)));
+  TEST_CHECK(ilps22qs_log_block_check(image[3], &hdr) == 0);
+  TEST_CHECK((hdr.seq == 3U) && (hdr.cnt == 10U) && (hdr.t0 == 50000U));
+
+  /* samples are the FIFO words, XL first */
+  rec = &image[1][ILPS22QS_LOG_HDR_SIZE];
+  word = (uint32_t)rec[0] | ((uint32_t)rec[1] << 8) | ((uint32_t)rec[2] << 16);
+  TEST_CHECK(word == ((1013U * 4096U) + ILPS22QS_LOG_SAMPLES));
+
+  /* any corrupted byte fails the CRC */
+  image[1][100] ^= 0x01U;
+  TEST_CHECK(ilps22qs_log_block_check(image[1], &hdr) == -1);
+
+  /* 1 Hz period in us ticks, timestamp past 2^32 */
+  TEST_CHECK(ilps22qs_log_init(&log, 7U, 1000000U, flush, NULL) == 0);
+  TEST_CHECK(ilps22qs_log_append(&log, 5000000000U, data, 3U) == 0);
+  TEST_CHECK(ilps22qs_log_flush(&log) == 0);
+  TEST_CHECK(ilps22qs_log_block_check(image[4], &hdr) == 0);
+  TEST_CHECK((hdr.t0 == 5000000000U) && (hdr.dt == 1000000U) &&
+             (hdr.cnt == 3U));
+
+  /* a failed flush keeps the block and its sequence number */
+  TEST_CHECK(ilps22qs_log_init(&log, 7U, 40U, flush, NULL) == 0);
+  fail = 1U;
+  TEST_CHECK(ilps22qs_log_append(&log, 0U, data,
+                                 (uint16_t)ILPS22QS_LOG_SAMPLES) == -1);
+  TEST_CHECK(ilps22qs_log_flush(&log) == -1);
+  TEST_CHECK((blocks == 5U) && (log.hdr.seq == 0U) &&
+             (log.hdr.cnt == ILPS22QS_LOG_SAMPLES));
+  fail = 0U;
+  TEST_CHECK(ilps22qs_log_append(&log, ILPS22QS_LOG_SAMPLES * 40U,
+                                 &data[ILPS22QS_LOG_SAMPLES], 2U) == 0);
+  TEST_CHECK(ilps22qs_log_flush(&log) == 0);
+  TEST_CHECK(blocks == 7U);
+  TEST_CHECK(ilps22qs_log_block_check(image[5], &hdr) == 0);
+  TEST_CHECK((hdr.seq == 0U) && (hdr.t0 == 0U) &&
+             (hdr.cnt == ILPS22QS_LOG_SAMPLES));
+  TEST_CHECK(ilps22qs_log_block_check(image[6], &hdr) == 0);
+  TEST_CHECK((hdr.seq == 1U) && (hdr.cnt == 2U) &&
+             (hdr.t0 == (ILPS22QS_LOG_SAMPLES * 40U)));
+
+  return test_report("log");
+}
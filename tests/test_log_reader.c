@@ -0,0 +1,131 @@
+/**
+  ******************************************************************************
+  * @file    test_log_reader.c
+  * @author  Sensors Software Solution Team
+  * @brief   sample log write / time-range read round-trip
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <math.h>
+#include <string.h>
+
+#define BLOCKS 16U
+#define N      1000U
+
+static uint8_t image[BLOCKS * ILPS22QS_LOG_BLOCK_SIZE];
+static uint32_t blocks;
+static ilps22qs_fifo_data_t data[N];
+static ilps22qs_fifo_data_t out[ILPS22QS_LOG_SAMPLES];
+
+static int32_t flush(void *handle, const uint8_t *block, uint16_t len)
+{
+  (void)handle;
+  if (blocks >= BLOCKS)
+  {
+    return -1;
+  }
+  (void)memcpy(&image[blocks * ILPS22QS_LOG_BLOCK_SIZE], block, len);
+  blocks++;
+
+  return 0;
+}
+
+/* FIFO word of sample i: odd samples tagged AH_QVAR when interleaved */
+static uint32_t word_of(uint32_t i, uint8_t interleaved)
+{
+  uint32_t word = (1000U * 4096U) + (i * 2U);
+
+  return (interleaved != 0U) ? (word | (i & 1U)) : word;
+}
+
+int main(void)
+{
+  static ilps22qs_log_t log_a, log_b, log_c;
+  ilps22qs_log_reader_t rd;
+  ilps22qs_log_idx_t idx[BLOCKS];
+  ilps22qs_log_iter_t it;
+  ilps22qs_md_t md;
+  uint32_t i, s, seen, expect;
+  uint64_t t0;
+  uint16_t num, k;
+
+  /* device 1 interleaved, device 2 plain, blocks of both in one image */
+  for (i = 0U; i < N; i++)
+  {
+    data[i].raw = (int32_t)(word_of(i, 1U) << 8);
+  }
+  TEST_CHECK(ilps22qs_log_init(&log_a, 1U, 10U, flush, NULL) == 0);
+  TEST_CHECK(ilps22qs_log_init(&log_b, 2U, 10U, flush, NULL) == 0);
+  for (i = 0U; i < N; i += 100U)
+  {
+    TEST_CHECK(ilps22qs_log_append(&log_a, i * 10U, &data[i], 100U) == 0);
+    TEST_CHECK(ilps22qs_log_append(&log_b, i * 10U, &data[i], 100U) == 0);
+  }
+  TEST_CHECK(ilps22qs_log_flush(&log_a) == 0);
+  TEST_CHECK(ilps22qs_log_flush(&log_b) == 0);
+
+  TEST_CHECK(ilps22qs_log_reader_init(&rd, image,
+                                      blocks * ILPS22QS_LOG_BLOCK_SIZE, 1U,
+                                      idx, BLOCKS) == 0);
+  TEST_CHECK(rd.idx_cnt == ((N + ILPS22QS_LOG_SAMPLES - 1U) /
+                            ILPS22QS_LOG_SAMPLES));
+
+  /* [2345, 7777] holds samples 235 .. 777 */
+  (void)memset(&md, 0, sizeof(md));
+  md.fs = ILPS22QS_1260hPa;
+  md.interleaved_mode = 1U;
+  TEST_CHECK(ilps22qs_log_range_first(&rd, 2345U, 7777U, &it) == 0);
+  seen = 0U;
+  expect = 235U;
+  do
+  {
+    TEST_CHECK(ilps22qs_log_range_next(&rd, &it, &md, out, &t0, &num) == 0);
+    for (k = 0U; k < num; k++)
+    {
+      s = (uint32_t)(t0 / 10U) + k;
+      TEST_CHECK(s == expect);
+      expect++;
+      if ((s & 1U) != 0U)
+      {
+        TEST_CHECK((out[k].hpa == 0.0f) &&
+                   (out[k].lsb == (int32_t)word_of(s, 1U)));
+      }
+      else
+      {
+        TEST_CHECK(fabsf(out[k].hpa - ((float_t)word_of(s, 1U) / 4096.0f)) <
+                   1e-3f);
+      }
+    }
+    seen += num;
+  } while (num != 0U);
+  TEST_CHECK(seen == (777U - 235U + 1U));
+
+  /* a corrupted block is reported */
+  image[idx[1].block * ILPS22QS_LOG_BLOCK_SIZE + 30U] ^= 0x80U;
+  TEST_CHECK(ilps22qs_log_range_first(&rd, 0U, 99999U, &it) == 0);
+  TEST_CHECK(ilps22qs_log_range_next(&rd, &it, &md, out, &t0, &num) == 0);
+  TEST_CHECK(ilps22qs_log_range_next(&rd, &it, &md, out, &t0, &num) == -1);
+
+  /* device 3 blocks out of time order are refused */
+  TEST_CHECK(ilps22qs_log_init(&log_c, 3U, 10U, flush, NULL) == 0);
+  TEST_CHECK(ilps22qs_log_append(&log_c, 5000U, data, 10U) == 0);
+  TEST_CHECK(ilps22qs_log_append(&log_c, 0U, data, 10U) == 0);
+  TEST_CHECK(ilps22qs_log_flush(&log_c) == 0);
+  TEST_CHECK(ilps22qs_log_reader_init(&rd, image,
+                                      blocks * ILPS22QS_LOG_BLOCK_SIZE, 3U,
+                                      idx, BLOCKS) == -1);
+
+  return test_report("log_reader");
+}
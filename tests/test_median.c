@@ -0,0 +1,95 @@
+/**
+  ******************************************************************************
+  * @file    test_median.c
+  * @author  Sensors Software Solution Team
+  * @brief   sliding median against a sort-per-window reference
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define WIN_MAX 16U
+#define N       400U
+
+static float_t in[N];
+
+static int cmp(const void *a, const void *b)
+{
+  float_t x = *(const float_t *)a, y = *(const float_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+/* lower and upper middle of the last min(k + 1, len) samples */
+static void reference(uint16_t k, uint16_t len, float_t *lo, float_t *hi)
+{
+  float_t win[WIN_MAX];
+  uint16_t n = ((k + 1U) < len) ? (uint16_t)(k + 1U) : len;
+
+  (void)memcpy(win, &in[k + 1U - n], n * sizeof(float_t));
+  qsort(win, n, sizeof(float_t), cmp);
+  *lo = win[(n - 1U) / 2U];
+  *hi = win[n / 2U];
+}
+
+int main(void)
+{
+  static const uint16_t lens[] = { 1U, 2U, 5U, 8U, 15U };
+  ilps22qs_median_t med;
+  ilps22qs_fifo_data_t data[16];
+  float_t buf[WIN_MAX], m, lo, hi;
+  uint16_t heap[WIN_MAX];
+  int16_t pos[WIN_MAX];
+  uint32_t seed = 7U;
+  uint16_t i, l;
+
+  for (i = 0U; i < N; i++)
+  {
+    seed = (seed * 1103515245U) + 12345U;
+    in[i] = 1000.0f + (float_t)((seed >> 16) % 64U) / 8.0f;
+  }
+
+  for (l = 0U; l < (sizeof(lens) / sizeof(lens[0])); l++)
+  {
+    TEST_CHECK(ilps22qs_median_init(&med, buf, pos, heap, lens[l],
+                                    0.0f) == 0);
+    for (i = 0U; i < N; i++)
+    {
+      m = ilps22qs_median_update(&med, in[i]);
+      reference(i, lens[l], &lo, &hi);
+      TEST_CHECK((m >= lo) && (m <= hi));
+    }
+  }
+
+  /* a 10 hPa spike is replaced, AH_QVAR samples are left untouched */
+  TEST_CHECK(ilps22qs_median_init(&med, buf, pos, heap, 5U, 1.0f) == 0);
+  (void)memset(data, 0, sizeof(data));
+  for (i = 0U; i < 16U; i++)
+  {
+    data[i].hpa = 1000.0f + ((float_t)i * 0.01f);
+  }
+  data[8].hpa = 1010.0f;
+  data[11].hpa = 0.0f;
+  TEST_CHECK(ilps22qs_median_apply(&med, data, 16U) == 0);
+  TEST_CHECK((data[8].hpa > 1000.0f) && (data[8].hpa < 1000.2f));
+  TEST_CHECK(data[7].hpa == (1000.0f + (7.0f * 0.01f)));
+  TEST_CHECK(data[11].hpa == 0.0f);
+
+  TEST_CHECK(ilps22qs_median_init(&med, buf, pos, heap, 0U, 1.0f) == -1);
+  TEST_CHECK(ilps22qs_median_init(&med, NULL, pos, heap, 5U, 1.0f) == -1);
+
+  return test_report("median");
+}
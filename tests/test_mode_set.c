@@ -0,0 +1,73 @@
+/**
+  ******************************************************************************
+  * @file    test_mode_set.c
+  * @author  Sensors Software Solution Team
+  * @brief   mode_set register values and bus transactions
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include <string.h>
+
+int main(void)
+{
+  mock_bus_t bus;
+  stmdev_ctx_t ctx;
+  ilps22qs_md_t md, rd;
+
+  mock_bus_init(&bus, &ctx);
+  (void)memset(&md, 0, sizeof(md));
+
+  /* ODR / AVG / LPF / FS change: one read list, one burst write */
+  md.odr = ILPS22QS_25Hz;
+  md.avg = ILPS22QS_16_AVG;
+  md.fs = ILPS22QS_4060hPa;
+  md.lpf = ILPS22QS_LPF_ODR_DIV_4;
+  mock_bus_count_reset(&bus);
+  TEST_CHECK(ilps22qs_mode_set(&ctx, &md) == 0);
+  TEST_CHECK(bus.rd == 2U);
+  TEST_CHECK(bus.wr == 1U);
+  TEST_CHECK(bus.wr_bytes == 3U);
+
+  (void)memset(&rd, 0, sizeof(rd));
+  TEST_CHECK(ilps22qs_mode_get(&ctx, &rd) == 0);
+  TEST_CHECK(rd.odr == ILPS22QS_25Hz);
+  TEST_CHECK(rd.avg == ILPS22QS_16_AVG);
+  TEST_CHECK(rd.fs == ILPS22QS_4060hPa);
+  TEST_CHECK(rd.lpf == ILPS22QS_LPF_ODR_DIV_4);
+  TEST_CHECK(rd.interleaved_mode == 0U);
+
+  /* LPF at ODR/9: EN_LPFP and LPFP_CFG both set */
+  md.lpf = ILPS22QS_LPF_ODR_DIV_9;
+  TEST_CHECK(ilps22qs_mode_set(&ctx, &md) == 0);
+  TEST_CHECK((bus.regs[ILPS22QS_CTRL_REG2] & 0x30U) == 0x30U);
+  TEST_CHECK(ilps22qs_mode_get(&ctx, &rd) == 0);
+  TEST_CHECK(rd.lpf == ILPS22QS_LPF_ODR_DIV_9);
+
+  /* interleaved change while running: power-down, CTRL_REG3, FIFO_CTRL */
+  md.interleaved_mode = 1U;
+  mock_bus_count_reset(&bus);
+  TEST_CHECK(ilps22qs_mode_set(&ctx, &md) == 0);
+  TEST_CHECK(bus.rd == 2U);
+  TEST_CHECK(bus.wr == 4U);
+  TEST_CHECK(ilps22qs_mode_get(&ctx, &rd) == 0);
+  TEST_CHECK(rd.interleaved_mode == 1U);
+  TEST_CHECK(rd.odr == ILPS22QS_25Hz);
+
+  /* same interleaved setting again: back to a single write */
+  mock_bus_count_reset(&bus);
+  TEST_CHECK(ilps22qs_mode_set(&ctx, &md) == 0);
+  TEST_CHECK(bus.wr == 1U);
+
+  return test_report("mode_set");
+}
@@ -0,0 +1,78 @@
+/**
+  ******************************************************************************
+  * @file    test_odr_ctl.c
+  * @author  Sensors Software Solution Team
+  * @brief   adaptive ODR controller
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <string.h>
+
+int main(void)
+{
+  mock_bus_t bus;
+  stmdev_ctx_t ctx;
+  ilps22qs_md_t prof[2];
+  ilps22qs_odr_ctl_t ctl;
+  ilps22qs_fifo_data_t data[10];
+  uint32_t k, i, ups = 0U, downs = 0U;
+  float_t p = 1000.0f;
+  uint8_t sw;
+  int32_t ok = 1;
+
+  mock_bus_init(&bus, &ctx);
+  (void)memset(prof, 0, sizeof(prof));
+  prof[0].odr = ILPS22QS_1Hz;
+  prof[0].avg = ILPS22QS_512_AVG;
+  prof[1].odr = ILPS22QS_10Hz;
+  prof[1].avg = ILPS22QS_64_AVG;
+
+  TEST_CHECK(ilps22qs_odr_ctl_init(&ctx, &ctl, prof, 2U, 2U, 2.0f, 0.5f, 0.1f,
+                                   5.0f) == -1);
+  TEST_CHECK(ilps22qs_odr_ctl_init(&ctx, &ctl, prof, 2U, 0U, 2.0f, 0.5f, 0.1f,
+                                   -1.0f) == -1);
+  TEST_CHECK(ilps22qs_odr_ctl_init(&ctx, &ctl, prof, 2U, 0U, 2.0f, 0.5f, 0.1f,
+                                   5.0f) == 0);
+
+  /* 1 hPa/sample ramp, then flat: one switch up, one back down */
+  for (k = 0U; k < 120U; k++)
+  {
+    for (i = 0U; i < 10U; i++)
+    {
+      p += ((k >= 10U) && (k < 30U)) ? 1.0f : 0.0f;
+      data[i].hpa = p;
+    }
+    mock_bus_count_reset(&bus);
+    ok &= (ilps22qs_odr_ctl_apply(&ctx, &ctl, data, 10U, &sw) == 0) ? 1 : 0;
+    if (sw != 0U)
+    {
+      /* profiles differing only in ODR / AVG: CTRL_REG1 read + write */
+      ok &= ((bus.rd == 1U) && (bus.wr == 1U)) ? 1 : 0;
+      ok &= (ctl.switch_at == ((k + 1U) * 10U)) ? 1 : 0;
+      ups += (ctl.cur == 1U) ? 1U : 0U;
+      downs += (ctl.cur == 0U) ? 1U : 0U;
+    }
+    else
+    {
+      ok &= ((bus.rd == 0U) && (bus.wr == 0U)) ? 1 : 0;
+    }
+  }
+  TEST_CHECK(ok != 0);
+  TEST_CHECK((ups == 1U) && (downs == 1U) && (ctl.switches == 2U));
+  TEST_CHECK(((bus.regs[ILPS22QS_CTRL_REG1] >> 3) & 0x0FU) ==
+             (uint8_t)ILPS22QS_1Hz);
+
+  return test_report("odr_ctl");
+}
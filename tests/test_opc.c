@@ -0,0 +1,84 @@
+/**
+  ******************************************************************************
+  * @file    test_opc.c
+  * @author  Sensors Software Solution Team
+  * @brief   one-point offset calibration
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <math.h>
+#include <string.h>
+
+/* 1001 hPa +/- 0.01 hPa with two outliers at 1010 hPa, 4096 LSB/hPa */
+static uint32_t opc_gen(mock_bus_t *bus, uint32_t idx)
+{
+  static const int32_t ripple[4] = { -41, 0, 41, 0 };
+
+  (void)bus;
+  if ((idx == 5U) || (idx == 20U))
+  {
+    return 1010U * 4096U;
+  }
+
+  return (uint32_t)((1001 * 4096) + ripple[idx % 4U]);
+}
+
+int main(void)
+{
+  mock_bus_t bus;
+  stmdev_ctx_t ctx;
+  ilps22qs_md_t md, rd;
+  ilps22qs_opc_cal_t cal;
+  ilps22qs_fifo_data_t buf[32];
+
+  mock_bus_init(&bus, &ctx);
+  bus.fifo_gen = opc_gen;
+  bus.fifo_level = 32U;
+  (void)memset(&md, 0, sizeof(md));
+  md.odr = ILPS22QS_1Hz;
+  md.fs = ILPS22QS_1260hPa;
+
+  TEST_CHECK(ilps22qs_opc_calibrate(&ctx, &md, 1000.0f, buf, 4U, &cal) == -1);
+
+  /* +1 hPa offset: 16 LSB in RPDS at 1260 hPa full scale */
+  TEST_CHECK(ilps22qs_opc_calibrate(&ctx, &md, 1000.0f, buf, 32U, &cal) == 0);
+  TEST_CHECK((cal.used == 30U) && (cal.rejected == 2U));
+  TEST_CHECK(fabsf(cal.offset_hpa - 1.0f) < 0.01f);
+  TEST_CHECK(cal.opc == 16);
+  TEST_CHECK((bus.regs[ILPS22QS_RPDS_L] == 16U) &&
+             (bus.regs[ILPS22QS_RPDS_H] == 0U));
+
+  /* the caller's mode is restored, the FIFO is back in bypass */
+  TEST_CHECK(ilps22qs_mode_get(&ctx, &rd) == 0);
+  TEST_CHECK((rd.odr == ILPS22QS_1Hz) && (rd.fs == ILPS22QS_1260hPa));
+  TEST_CHECK((bus.regs[ILPS22QS_FIFO_CTRL] & 0x07U) == 0U);
+
+  /* a second run adds to the programmed value */
+  TEST_CHECK(ilps22qs_opc_calibrate(&ctx, &md, 1000.5f, buf, 32U, &cal) == 0);
+  TEST_CHECK(cal.opc == 24);
+
+  /* the caller's FIFO configuration survives, also on a fill timeout */
+  bus.regs[ILPS22QS_FIFO_CTRL] = 0x02U;
+  bus.regs[ILPS22QS_FIFO_WTM] = 5U;
+  TEST_CHECK(ilps22qs_opc_calibrate(&ctx, &md, 1001.0f, buf, 32U, &cal) == 0);
+  TEST_CHECK((bus.regs[ILPS22QS_FIFO_CTRL] == 0x02U) &&
+             (bus.regs[ILPS22QS_FIFO_WTM] == 5U));
+  bus.fifo_level = 0U;
+  TEST_CHECK(ilps22qs_opc_calibrate(&ctx, &md, 1001.0f, buf, 32U, &cal) != 0);
+  TEST_CHECK((bus.regs[ILPS22QS_FIFO_CTRL] == 0x02U) &&
+             (bus.regs[ILPS22QS_FIFO_WTM] == 5U));
+
+  return test_report("opc");
+}
@@ -0,0 +1,88 @@
+/**
+  ******************************************************************************
+  * @file    test_pair.c
+  * @author  Sensors Software Solution Team
+  * @brief   pressure / AH_QVAR pairing of interleaved streams
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <math.h>
+#include <string.h>
+
+/* slot s: AH_QVAR at s mV when s is even, pressure 1000 + s hPa if odd */
+static void pair_slot(ilps22qs_fifo_data_t *d, uint32_t s)
+{
+  (void)memset(d, 0, sizeof(ilps22qs_fifo_data_t));
+  if ((s & 1U) != 0U)
+  {
+    d->hpa = 1000.0f + (float_t)s;
+  }
+  else
+  {
+    d->lsb = (int32_t)(s * 438000U);
+  }
+}
+
+int main(void)
+{
+  ilps22qs_pair_t pair;
+  ilps22qs_pair_data_t out[8];
+  ilps22qs_fifo_data_t data[10];
+  uint16_t num;
+  uint32_t s;
+  int32_t ok = 1;
+
+  TEST_CHECK(ilps22qs_pair_init(&pair, ILPS22QS_ONE_SHOT) == -1);
+  TEST_CHECK(ilps22qs_pair_init(&pair, ILPS22QS_10Hz) == 0);
+
+  /* slots 0 .. 9: four tuples, the pressure of slot 9 waits */
+  for (s = 0U; s < 10U; s++)
+  {
+    pair_slot(&data[s], s);
+  }
+  TEST_CHECK(ilps22qs_pair_apply(&pair, data, 10U, out, 8U, &num) == 0);
+  TEST_CHECK(num == 4U);
+  for (s = 0U; s < 4U; s++)
+  {
+    /* AH/QVAR interpolated to the pressure slot */
+    ok &= (fabsf(out[s].hpa - (1001.0f + (2.0f * (float_t)s))) < 1e-3f) ?
+          1 : 0;
+    ok &= (fabsf(out[s].mv - (1.0f + (2.0f * (float_t)s))) < 1e-3f) ? 1 : 0;
+    ok &= (out[s].n == (1U + (2U * s))) ? 1 : 0;
+  }
+  TEST_CHECK(ok != 0);
+
+  /* slot 10 completes slot 9; slot 11 is lost, slot 13 keeps its index */
+  pair_slot(&data[0], 10U);
+  pair_slot(&data[1], 12U);
+  pair_slot(&data[2], 13U);
+  pair_slot(&data[3], 14U);
+  TEST_CHECK(ilps22qs_pair_apply(&pair, data, 4U, out, 8U, &num) == 0);
+  TEST_CHECK((num == 2U) && (pair.slips == 1U));
+  TEST_CHECK((fabsf(out[0].mv - 9.0f) < 1e-3f) &&
+             (out[0].n == 9U));
+  TEST_CHECK((fabsf(out[1].hpa - 1013.0f) < 1e-3f) &&
+             (out[1].n == 13U));
+
+  /* no room for the tuples */
+  for (s = 0U; s < 10U; s++)
+  {
+    pair_slot(&data[s], 16U + s);
+  }
+  TEST_CHECK(ilps22qs_pair_apply(&pair, data, 10U, out, 2U, &num) == -1);
+  TEST_CHECK(num == 2U);
+
+  return test_report("pair");
+}
@@ -0,0 +1,92 @@
+/**
+  ******************************************************************************
+  * @file    test_qvar_det.c
+  * @author  Sensors Software Solution Team
+  * @brief   streaming AH/QVAR event detector
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <string.h>
+
+/* 10 mV +/- 0.1 mV at rest, 20 mV while touched */
+static float_t qvar_mv(uint16_t i)
+{
+  float_t mv = ((i & 1U) != 0U) ? 10.1f : 9.9f;
+
+  return ((i >= 60U) && (i < 80U)) ? (mv + 10.0f) : mv;
+}
+
+int main(void)
+{
+  ilps22qs_qvar_det_t det;
+  ilps22qs_qvar_evt_t ev[4];
+  ilps22qs_fifo_data_t data[200];
+  uint16_t i, start = 0U, end = 0U, num = 0U;
+  ilps22qs_qvar_ev_t e;
+
+  TEST_CHECK(ilps22qs_qvar_det_init(&det, 0.1f, 5.0f, 1.0f, 0U, 0U) == -1);
+  TEST_CHECK(ilps22qs_qvar_det_init(&det, 0.0f, 5.0f, 1.0f, 3U, 0U) == -1);
+  TEST_CHECK(ilps22qs_qvar_det_init(&det, 0.1f, 5.0f, 0.0f, 3U, 0U) == -1);
+
+  /* START and END are reported exactly debounce samples after the edge */
+  TEST_CHECK(ilps22qs_qvar_det_init(&det, 0.1f, 5.0f, 1.0f, 3U, 0U) == 0);
+  for (i = 0U; i < 100U; i++)
+  {
+    e = ilps22qs_qvar_det_update(&det, qvar_mv(i));
+    start = (e == ILPS22QS_QVAR_EV_START) ? i : start;
+    end = (e == ILPS22QS_QVAR_EV_END) ? i : end;
+    num += (e != ILPS22QS_QVAR_EV_NONE) ? 1U : 0U;
+  }
+  TEST_CHECK((num == 2U) && (start == 62U) && (end == 82U));
+
+  /* a permanent step ends after max_active samples, then is the baseline */
+  TEST_CHECK(ilps22qs_qvar_det_init(&det, 0.1f, 5.0f, 1.0f, 3U, 30U) == 0);
+  num = 0U;
+  for (i = 0U; i < 200U; i++)
+  {
+    e = ilps22qs_qvar_det_update(&det, qvar_mv(i) +
+                                 ((i >= 60U) ? 10.0f : 0.0f));
+    start = (e == ILPS22QS_QVAR_EV_START) ? i : start;
+    end = (e == ILPS22QS_QVAR_EV_END) ? i : end;
+    num += (e != ILPS22QS_QVAR_EV_NONE) ? 1U : 0U;
+  }
+  TEST_CHECK((num == 2U) && (start == 62U) && (end == 92U));
+
+  /* interleaved batch: only the AH_QVAR words feed the detector */
+  (void)memset(data, 0, sizeof(data));
+  for (i = 0U; i < 200U; i++)
+  {
+    if ((i & 1U) == 0U)
+    {
+      data[i].hpa = 1000.0f;
+    }
+    else
+    {
+      data[i].lsb = (int32_t)(qvar_mv(i / 2U) * 438000.0f);
+    }
+  }
+  TEST_CHECK(ilps22qs_qvar_det_init(&det, 0.1f, 5.0f, 1.0f, 3U, 0U) == 0);
+  TEST_CHECK(ilps22qs_qvar_det_apply(&det, data, 200U, ev, 4U, &num) == 0);
+  TEST_CHECK((num == 2U) && (ev[0].ev == ILPS22QS_QVAR_EV_START) &&
+             (ev[0].idx == 125U) && (ev[1].ev == ILPS22QS_QVAR_EV_END) &&
+             (ev[1].idx == 165U));
+
+  /* no room for the events */
+  TEST_CHECK(ilps22qs_qvar_det_init(&det, 0.1f, 5.0f, 1.0f, 3U, 0U) == 0);
+  TEST_CHECK(ilps22qs_qvar_det_apply(&det, data, 200U, ev, 1U, &num) == -1);
+  TEST_CHECK(num == 1U);
+
+  return test_report("qvar_det");
+}
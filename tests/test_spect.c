@@ -0,0 +1,92 @@
+/**
+  ******************************************************************************
+  * @file    test_spect.c
+  * @author  Sensors Software Solution Team
+  * @brief   Goertzel-bank spectral analysis
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+int main(void)
+{
+  static const float_t f_lo[2] = { 10.0f, 40.0f };
+  static const float_t f_hi[2] = { 30.0f, 60.0f };
+  static const float_t f_il[2] = { 30.0f, 48.0f };
+  static const float_t f_nar[1] = { 10.2f };
+  ilps22qs_fifo_data_t data[32];
+  ilps22qs_spect_data_t out[4];
+  ilps22qs_spect_t spec;
+  ilps22qs_md_t md;
+  uint16_t num, i;
+  uint32_t k, n = 0U;
+  clock_t c0;
+  double s;
+
+  (void)memset(&md, 0, sizeof(md));
+  md.odr = ILPS22QS_200Hz;
+  TEST_CHECK(ilps22qs_spect_init(&spec, &md, 4U, 2U, f_lo, f_hi, 2U) == -1);
+  TEST_CHECK(ilps22qs_spect_init(&spec, &md, 128U, 64U, f_hi, f_lo, 2U) ==
+             -1);
+  TEST_CHECK(ilps22qs_spect_init(&spec, &md, 128U, 64U, f_nar, f_nar, 1U) ==
+             -1);
+  TEST_CHECK(ilps22qs_spect_init(&spec, &md, 128U, 64U, f_lo, f_hi, 2U) == 0);
+
+  /* 0.2 hPa at 20.3 Hz: 0.02 hPa^2 in the first band, none in the second */
+  (void)memset(data, 0, sizeof(data));
+  c0 = clock();
+  for (k = 0U; k < 20000U; k++)
+  {
+    for (i = 0U; i < 32U; i++)
+    {
+      data[i].hpa = 1000.0f + (0.2f * sinf(6.2831853f * 20.3f *
+                                           ((float_t)n / 200.0f)));
+      n++;
+    }
+    TEST_CHECK(ilps22qs_spect_apply(&spec, data, 32U, out, 4U, &num) == 0);
+  }
+  s = (double)(clock() - c0) / CLOCKS_PER_SEC;
+
+  TEST_CHECK((fabsf(out[0].energy[0] - 0.02f) < 0.002f) &&
+             (out[0].energy[1] < 0.0002f));
+  if (s > 0.0)
+  {
+    /* depends on the host, only indicative */
+    printf("spect: %u bins, %.0f samples/s\n", spec.bins, (double)n / s);
+  }
+
+  /* interleaved at 200 Hz: the same tone on the 100 Hz pressure slots */
+  md.interleaved_mode = 1U;
+  (void)memset(out, 0, sizeof(out));
+  TEST_CHECK(ilps22qs_spect_init(&spec, &md, 64U, 32U, f_lo, f_il, 2U) == 0);
+  n = 0U;
+  for (k = 0U; k < 100U; k++)
+  {
+    for (i = 0U; i < 32U; i += 2U)
+    {
+      data[i].hpa = 1000.0f + (0.2f * sinf(6.2831853f * 20.3f *
+                                           ((float_t)n / 100.0f)));
+      data[i + 1U].hpa = 0.0f;
+      n++;
+    }
+    TEST_CHECK(ilps22qs_spect_apply(&spec, data, 32U, out, 4U, &num) == 0);
+  }
+  TEST_CHECK((fabsf(out[0].energy[0] - 0.02f) < 0.002f) &&
+             (out[0].energy[1] < 0.0002f));
+
+  return test_report("spect");
+}
@@ -0,0 +1,136 @@
+/**
+  ******************************************************************************
+  * @file    test_spidev.c
+  * @author  Sensors Software Solution Team
+  * @brief   spidev backend against a loopback ioctl on the mock registers
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_spidev.h"
+#include <string.h>
+#include <linux/spi/spidev.h>
+
+static mock_bus_t bus;
+static uint32_t cs_cycles;
+static uint32_t addr_bytes[256];
+
+/* SPI slave model: first byte after chip select is the address */
+static int loopback_ioctl(int fd, unsigned long req, void *arg)
+{
+  struct spi_ioc_transfer *tr = (struct spi_ioc_transfer *)arg;
+  uint32_t n = _IOC_SIZE(req) / sizeof(struct spi_ioc_transfer);
+  uint8_t *tx, *rx, addr = 0U, cs = 0U;
+  uint32_t i, k;
+
+  (void)fd;
+  for (i = 0U; i < n; i++)
+  {
+    tx = (uint8_t *)(uintptr_t)tr[i].tx_buf;
+    rx = (uint8_t *)(uintptr_t)tr[i].rx_buf;
+    for (k = 0U; k < tr[i].len; k++)
+    {
+      if (cs == 0U)
+      {
+        addr = tx[k];
+        addr_bytes[addr]++;
+        cs = 1U;
+        cs_cycles++;
+      }
+      else if ((addr & ILPS22QS_SPI_READ_BIT) != 0U)
+      {
+        rx[k] = mock_bus_get(&bus, addr & ILPS22QS_SPI_ADD_MASK);
+        addr = (uint8_t)((addr & 0x80U) | ((addr + 1U) & 0x7FU));
+      }
+      else
+      {
+        mock_bus_put(&bus, addr, tx[k]);
+        addr = (uint8_t)((addr + 1U) & 0x7FU);
+      }
+    }
+    if (tr[i].cs_change != 0U)
+    {
+      cs = 0U;
+    }
+  }
+
+  return 0;
+}
+
+int main(void)
+{
+  ilps22qs_spidev_t spi;
+  ilps22qs_spidev_txn_t txn[3];
+  stmdev_ctx_t ctx, drv;
+  ilps22qs_id_t id;
+  ilps22qs_md_t md;
+  ilps22qs_data_t data;
+  uint8_t buf[4] = { 0x11U, 0x22U, 0x33U, 0x44U };
+  uint8_t status = 0U, press[3] = { 0 }, fifo[3] = { 0 };
+
+  mock_bus_init(&bus, &ctx);
+  (void)memset(&spi, 0, sizeof(spi));
+  spi.ioctl = loopback_ioctl;
+  (void)memset(&drv, 0, sizeof(drv));
+  drv.write_reg = ilps22qs_spidev_write;
+  drv.read_reg = ilps22qs_spidev_read;
+  drv.handle = &spi;
+
+  /* read bit in the address byte, auto-increment on the data */
+  TEST_CHECK(ilps22qs_spidev_write(&spi, 0x30U, buf, 4U) == 0);
+  TEST_CHECK(addr_bytes[0x30U] == 1U);
+  TEST_CHECK(memcmp(&bus.regs[0x30U], buf, 4U) == 0);
+  (void)memset(buf, 0, sizeof(buf));
+  TEST_CHECK(ilps22qs_spidev_read(&spi, 0x30U, buf, 4U) == 0);
+  TEST_CHECK(addr_bytes[0x30U | ILPS22QS_SPI_READ_BIT] == 1U);
+  TEST_CHECK((buf[0] == 0x11U) && (buf[3] == 0x44U));
+
+  /* driver on top of the backend: one syscall per driver call */
+  spi.syscalls = 0U;
+  TEST_CHECK(ilps22qs_id_get(&drv, &id) == 0);
+  TEST_CHECK(id.whoami == ILPS22QS_ID);
+  bus.regs[ILPS22QS_PRESS_OUT_XL] = 0x00U;
+  bus.regs[ILPS22QS_PRESS_OUT_XL + 1U] = 0x00U;
+  bus.regs[ILPS22QS_PRESS_OUT_XL + 2U] = 0x40U; /* 1024 hPa at 1260 hPa fs */
+  (void)memset(&md, 0, sizeof(md));
+  md.fs = ILPS22QS_1260hPa;
+  TEST_CHECK(ilps22qs_data_get(&drv, &md, &data) == 0);
+  TEST_CHECK((data.pressure.hpa > 1023.9f) && (data.pressure.hpa < 1024.1f));
+  TEST_CHECK(spi.syscalls == 2U);
+
+  /* status + pressure + FIFO word: three chip selects, one syscall */
+  spi.syscalls = 0U;
+  cs_cycles = 0U;
+  txn[0].reg = ILPS22QS_STATUS;
+  txn[0].write = 0U;
+  txn[0].data = &status;
+  txn[0].len = 1U;
+  txn[1].reg = ILPS22QS_PRESS_OUT_XL;
+  txn[1].write = 0U;
+  txn[1].data = press;
+  txn[1].len = 3U;
+  txn[2].reg = ILPS22QS_FIFO_DATA_OUT_PRESS_XL;
+  txn[2].write = 0U;
+  txn[2].data = fifo;
+  txn[2].len = 3U;
+  TEST_CHECK(ilps22qs_spidev_batch(&spi, txn, 3U) == 0);
+  TEST_CHECK(spi.syscalls == 1U);
+  TEST_CHECK(cs_cycles == 3U);
+  TEST_CHECK(press[2] == 0x40U);
+
+  TEST_CHECK(ilps22qs_spidev_batch(&spi, txn, 0U) == -1);
+  TEST_CHECK(ilps22qs_spidev_batch(&spi, txn,
+                                   ILPS22QS_SPIDEV_TXN_MAX + 1U) == -1);
+
+  return test_report("spidev");
+}
@@ -0,0 +1,112 @@
+/**
+  ******************************************************************************
+  * @file    test_stats.c
+  * @author  Sensors Software Solution Team
+  * @brief   incremental statistics and sliding min / max
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <math.h>
+#include <string.h>
+
+#define N   100U
+#define WIN 7U
+
+static ilps22qs_fifo_data_t data[N];
+
+int main(void)
+{
+  ilps22qs_stats_t all, a, b;
+  ilps22qs_minmax_t mm;
+  ilps22qs_minmax_item_t min_q[WIN], max_q[WIN];
+  ilps22qs_md_t md;
+  float_t mean = 0.0f, var = 0.0f, lo, hi, min, max;
+  uint32_t seed = 3U;
+  uint16_t i, k;
+
+  (void)memset(data, 0, sizeof(data));
+  for (i = 0U; i < N; i++)
+  {
+    seed = (seed * 1103515245U) + 12345U;
+    data[i].hpa = 1000.0f + ((float_t)((seed >> 16) % 100U) / 100.0f);
+    mean += data[i].hpa - 1000.0f;
+  }
+  mean /= (float_t)N;
+  for (i = 0U; i < N; i++)
+  {
+    var += (data[i].hpa - 1000.0f - mean) * (data[i].hpa - 1000.0f - mean);
+  }
+  var /= (float_t)(N - 1U);
+
+  /* one pass, and two halves merged, give the reference values */
+  TEST_CHECK(ilps22qs_stats_init(&all) == 0);
+  TEST_CHECK(ilps22qs_stats_add(&all, data, (uint16_t)N) == 0);
+  TEST_CHECK(fabsf(ilps22qs_stats_mean(&all) - (1000.0f + mean)) < 1e-3f);
+  TEST_CHECK(fabsf(ilps22qs_stats_variance(&all) - var) < 1e-4f);
+  TEST_CHECK(ilps22qs_stats_init(&a) == 0);
+  TEST_CHECK(ilps22qs_stats_init(&b) == 0);
+  TEST_CHECK(ilps22qs_stats_add(&a, data, 30U) == 0);
+  TEST_CHECK(ilps22qs_stats_add(&b, &data[30], (uint16_t)(N - 30U)) == 0);
+  TEST_CHECK(ilps22qs_stats_merge(&a, &b) == 0);
+  TEST_CHECK(a.n == N);
+  TEST_CHECK(fabsf(ilps22qs_stats_mean(&a) - ilps22qs_stats_mean(&all)) <
+             1e-3f);
+  TEST_CHECK(fabsf(ilps22qs_stats_variance(&a) - var) < 1e-4f);
+  TEST_CHECK((a.min == all.min) && (a.max == all.max));
+
+  /* 0.1 hPa per sample at 10 Hz is 1 hPa/s */
+  TEST_CHECK(ilps22qs_stats_init(&a) == 0);
+  for (i = 0U; i < 20U; i++)
+  {
+    data[i].hpa = 1000.0f + ((float_t)i * 0.1f);
+  }
+  TEST_CHECK(ilps22qs_stats_add(&a, data, 20U) == 0);
+  (void)memset(&md, 0, sizeof(md));
+  md.odr = ILPS22QS_10Hz;
+  TEST_CHECK(fabsf(ilps22qs_stats_rate(&a, &md) - 1.0f) < 1e-3f);
+  /* interleaved: one pressure sample every 0.2 s */
+  md.interleaved_mode = 1U;
+  TEST_CHECK(fabsf(ilps22qs_stats_rate(&a, &md) - 0.5f) < 1e-3f);
+
+  /* AH_QVAR samples are skipped */
+  data[5].hpa = 0.0f;
+  TEST_CHECK(ilps22qs_stats_init(&a) == 0);
+  TEST_CHECK(ilps22qs_stats_add(&a, data, 20U) == 0);
+  TEST_CHECK((a.n == 19U) && (a.min == 1000.0f));
+
+  /* sliding min / max against a brute force window */
+  TEST_CHECK(ilps22qs_minmax_init(&mm, min_q, max_q, (uint16_t)WIN) == 0);
+  TEST_CHECK(ilps22qs_minmax_get(&mm, &min, &max) == -1);
+  for (i = 0U; i < N; i++)
+  {
+    seed = (seed * 1103515245U) + 12345U;
+    data[i].hpa = 1000.0f + ((float_t)((seed >> 16) % 100U) / 100.0f);
+  }
+  for (i = 0U; i < N; i++)
+  {
+    TEST_CHECK(ilps22qs_minmax_add(&mm, &data[i], 1U) == 0);
+    lo = data[i].hpa;
+    hi = data[i].hpa;
+    for (k = (i >= WIN) ? (uint16_t)(i + 1U - WIN) : 0U; k <= i; k++)
+    {
+      lo = (data[k].hpa < lo) ? data[k].hpa : lo;
+      hi = (data[k].hpa > hi) ? data[k].hpa : hi;
+    }
+    TEST_CHECK(ilps22qs_minmax_get(&mm, &min, &max) == 0);
+    TEST_CHECK((min == lo) && (max == hi));
+  }
+
+  return test_report("stats");
+}
@@ -0,0 +1,82 @@
+/**
+  ******************************************************************************
+  * @file    test_tcomp.c
+  * @author  Sensors Software Solution Team
+  * @brief   table-based temperature compensation
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <math.h>
+#include <string.h>
+
+/* 900 / 1100 hPa by 0 / 40 degC */
+static const float_t tc_corr[4] = { 0.0f, 0.2f, 0.4f, 0.6f };
+
+/* 900 / 1156 hPa by 0 / 40.96 degC, 1/4096 hPa */
+static const int16_t tc_corr_fx[4] = { 0, 4096, 4096, 8192 };
+
+int main(void)
+{
+  ilps22qs_tcomp_t tc;
+  ilps22qs_tcomp_fx_t fx;
+  ilps22qs_fifo_data_t data[2];
+  ilps22qs_md_t md;
+
+  tc.corr = tc_corr;
+  tc.p0 = 900.0f;
+  tc.p_step = 200.0f;
+  tc.t0 = 0.0f;
+  tc.t_step = 40.0f;
+  tc.np = 2U;
+  tc.nt = 2U;
+
+  /* bilinear at the cell centre, clamped outside the grid */
+  TEST_CHECK(fabsf(ilps22qs_tcomp_get(&tc, 1000.0f, 20.0f) - 0.3f) < 1e-5f);
+  TEST_CHECK(fabsf(ilps22qs_tcomp_get(&tc, 800.0f, -10.0f)) < 1e-6f);
+  TEST_CHECK(fabsf(ilps22qs_tcomp_get(&tc, 1200.0f, 60.0f) - 0.6f) < 1e-5f);
+
+  /* batch correction skips the samples with no pressure */
+  (void)memset(data, 0, sizeof(data));
+  data[0].hpa = 1000.0f;
+  TEST_CHECK(ilps22qs_tcomp_apply(&tc, 20.0f, data, 2U) == 0);
+  TEST_CHECK(fabsf(data[0].hpa - 1000.3f) < 1e-3f);
+  TEST_CHECK(data[1].hpa == 0.0f);
+  TEST_CHECK(ilps22qs_tcomp_apply(NULL, 20.0f, data, 2U) == -1);
+
+  /* fixed point: 256 hPa and 40.96 degC steps, +1 hPa at the centre */
+  fx.corr = tc_corr_fx;
+  fx.p0 = 900 * 16;
+  fx.t0 = 0;
+  fx.p_shift = 12U;
+  fx.t_shift = 12U;
+  fx.np = 2U;
+  fx.nt = 2U;
+  (void)memset(&md, 0, sizeof(md));
+  md.fs = ILPS22QS_1260hPa;
+  (void)memset(data, 0, sizeof(data));
+  data[0].raw = (int32_t)((1028U * 4096U) << 8);
+  TEST_CHECK(ilps22qs_tcomp_apply_fx(&fx, &md, 2048, data, 1U) == 0);
+  TEST_CHECK(data[0].raw == (int32_t)((1029U * 4096U) << 8));
+
+  /* interleaved: the AH_QVAR word (tag bit set) is left as is */
+  md.interleaved_mode = 1U;
+  data[0].raw = (int32_t)((1028U * 4096U) << 8);
+  data[1].raw = (int32_t)(((1028U * 4096U) | 1U) << 8);
+  TEST_CHECK(ilps22qs_tcomp_apply_fx(&fx, &md, 2048, data, 2U) == 0);
+  TEST_CHECK(data[0].raw == (int32_t)((1029U * 4096U) << 8));
+  TEST_CHECK(data[1].raw == (int32_t)(((1028U * 4096U) | 1U) << 8));
+
+  return test_report("tcomp");
+}
@@ -0,0 +1,92 @@
+/**
+  ******************************************************************************
+  * @file    test_trace.c
+  * @author  Sensors Software Solution Team
+  * @brief   bus trace record and replay
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <string.h>
+
+static uint32_t now;
+
+static uint32_t tick(void)
+{
+  now += 5U;
+
+  return now;
+}
+
+/* the driver calls under trace */
+static int32_t session(stmdev_ctx_t *ctx, ilps22qs_data_t *data)
+{
+  ilps22qs_id_t id;
+  ilps22qs_md_t md;
+  int32_t ret;
+
+  (void)memset(&md, 0, sizeof(md));
+  md.odr = ILPS22QS_25Hz;
+  md.fs = ILPS22QS_1260hPa;
+  ret = ilps22qs_id_get(ctx, &id);
+  ret += ilps22qs_mode_set(ctx, &md);
+  ret += ilps22qs_data_get(ctx, &md, data);
+
+  return ret;
+}
+
+int main(void)
+{
+  static ilps22qs_trace_t trace;
+  ilps22qs_trace_rec_t rec[32];
+  ilps22qs_trace_stats_t stats;
+  uint8_t payload[256];
+  mock_bus_t bus;
+  stmdev_ctx_t dev, ctx;
+  ilps22qs_data_t live, replay;
+  ilps22qs_id_t id;
+
+  mock_bus_init(&bus, &dev);
+  bus.regs[ILPS22QS_PRESS_OUT_XL + 2U] = 0x3FU;
+
+  /* record on the mock bus */
+  (void)memset(&ctx, 0, sizeof(ctx));
+  TEST_CHECK(ilps22qs_trace_rec_init(&trace, &dev, tick, rec, 32U, payload,
+                                     sizeof(payload), &ctx) == 0);
+  TEST_CHECK(session(&ctx, &live) == 0);
+  TEST_CHECK(trace.rec_cnt == (bus.rd + bus.wr));
+  TEST_CHECK(ilps22qs_trace_stats_get(rec, trace.rec_cnt, &stats) == 0);
+  TEST_CHECK(stats.transactions == trace.rec_cnt);
+  TEST_CHECK(stats.bytes == (bus.rd_bytes + bus.wr_bytes));
+  TEST_CHECK(stats.span == (5U * (trace.rec_cnt - 1U)));
+
+  /* replay without the device: same results, same counters */
+  TEST_CHECK(ilps22qs_trace_replay_init(&trace, tick, rec, stats.transactions,
+                                        payload, sizeof(payload), &ctx) == 0);
+  TEST_CHECK(ctx.mdelay != NULL);
+  TEST_CHECK(session(&ctx, &replay) == 0);
+  TEST_CHECK(trace.diverged == 0U);
+  TEST_CHECK(replay.pressure.raw == live.pressure.raw);
+  TEST_CHECK(trace.live.transactions == stats.transactions);
+  TEST_CHECK(trace.live.bytes == stats.bytes);
+
+  /* a different call sequence is flagged */
+  TEST_CHECK(ilps22qs_trace_replay_init(&trace, tick, rec, stats.transactions,
+                                        payload, sizeof(payload), &ctx) == 0);
+  TEST_CHECK(ilps22qs_id_get(&ctx, &id) == 0);
+  TEST_CHECK(ilps22qs_id_get(&ctx, &id) != 0);
+  TEST_CHECK(trace.diverged == 1U);
+
+  return test_report("trace");
+}
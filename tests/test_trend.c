@@ -0,0 +1,76 @@
+/**
+  ******************************************************************************
+  * @file    test_trend.c
+  * @author  Sensors Software Solution Team
+  * @brief   multi-resolution rolling trend store
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <math.h>
+#include <string.h>
+
+int main(void)
+{
+  static ilps22qs_trend_t tr;
+  ilps22qs_fifo_data_t data[40];
+  ilps22qs_trend_val_t val;
+  uint32_t t, hours;
+  uint16_t i;
+  float_t dp;
+  int32_t ok;
+
+  /* 10 Hz batch: AH_QVAR words skipped, 1 s buckets of 10 samples */
+  (void)memset(data, 0, sizeof(data));
+  for (i = 0U; i < 40U; i++)
+  {
+    data[i].hpa = ((i % 5U) == 4U) ? 0.0f : (1000.0f + (float_t)i);
+  }
+  TEST_CHECK(ilps22qs_trend_init(&tr) == 0);
+  TEST_CHECK(ilps22qs_trend_apply(&tr, 0U, 0.1f, data, 40U) == 0);
+  TEST_CHECK(ilps22qs_trend_get(&tr, ILPS22QS_TREND_SEC, 0U, &val) == 0);
+  TEST_CHECK((val.cnt == 8U) && (fabsf(val.min - 1020.0f) < 1e-3f) &&
+             (fabsf(val.max - 1028.0f) < 1e-3f) &&
+             (fabsf(val.mean - 1024.0f) < 1e-3f));
+  TEST_CHECK(ilps22qs_trend_get(&tr, ILPS22QS_TREND_SEC, 3U, &val) != 0);
+
+  /* one sample every 10 s, the pressure is 1000 hPa + hour index */
+  hours = ILPS22QS_TREND_HOUR_N + 10U;
+  ok = (ilps22qs_trend_init(&tr) == 0) ? 1 : 0;
+  for (t = 0U; t <= (hours * 3600U); t += 10U)
+  {
+    ok &= (ilps22qs_trend_add(&tr, t, 1000.0f + (float_t)(t / 3600U)) == 0) ?
+          1 : 0;
+  }
+  TEST_CHECK(ok != 0);
+
+  /* last completed hour is hours - 1, the oldest kept is HOUR_N older */
+  TEST_CHECK(ilps22qs_trend_get(&tr, ILPS22QS_TREND_HOUR, 0U, &val) == 0);
+  TEST_CHECK((fabsf(val.mean - (1000.0f + (float_t)(hours - 1U))) < 1e-3f) &&
+             (val.cnt == 360U));
+  TEST_CHECK(ilps22qs_trend_get(&tr, ILPS22QS_TREND_HOUR,
+                                (uint16_t)(ILPS22QS_TREND_HOUR_N - 1U),
+                                &val) == 0);
+  TEST_CHECK(fabsf(val.mean - (1000.0f + (float_t)(hours -
+                                                    ILPS22QS_TREND_HOUR_N))) <
+             1e-3f);
+  TEST_CHECK(ilps22qs_trend_get(&tr, ILPS22QS_TREND_HOUR,
+                                (uint16_t)ILPS22QS_TREND_HOUR_N, &val) != 0);
+
+  /* 3-hour tendency */
+  TEST_CHECK(ilps22qs_trend_delta(&tr, ILPS22QS_TREND_HOUR, 3U, &dp) == 0);
+  TEST_CHECK(fabsf(dp - 3.0f) < 1e-3f);
+
+  return test_report("trend");
+}
@@ -0,0 +1,100 @@
+/**
+  ******************************************************************************
+  * @file    test_woc.c
+  * @author  Sensors Software Solution Team
+  * @brief   wake on change on the threshold interrupt
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#include "mock_bus.h"
+#include "ilps22qs_proc.h"
+#include <math.h>
+#include <string.h>
+
+/* pressure output registers at 4096 LSB/hPa (1260 hPa full scale) */
+static void press_set(mock_bus_t *bus, float_t hpa)
+{
+  uint32_t word = (uint32_t)(hpa * 4096.0f);
+
+  bus->regs[ILPS22QS_PRESS_OUT_XL] = (uint8_t)word;
+  bus->regs[ILPS22QS_PRESS_OUT_L] = (uint8_t)(word >> 8);
+  bus->regs[ILPS22QS_PRESS_OUT_H] = (uint8_t)(word >> 16);
+}
+
+/* reference captured by AUTOREFP, hPa * 16 */
+static void ref_set(mock_bus_t *bus, float_t hpa)
+{
+  uint16_t ref = (uint16_t)(hpa * 16.0f);
+
+  bus->regs[ILPS22QS_REF_P_L] = (uint8_t)ref;
+  bus->regs[ILPS22QS_REF_P_H] = (uint8_t)(ref >> 8);
+}
+
+int main(void)
+{
+  mock_bus_t bus;
+  stmdev_ctx_t ctx;
+  ilps22qs_md_t md;
+  ilps22qs_woc_t woc;
+  float_t hpa = 0.0f;
+  uint8_t changed = 0U;
+
+  mock_bus_init(&bus, &ctx);
+  (void)memset(&md, 0, sizeof(md));
+  md.odr = ILPS22QS_10Hz;
+  md.fs = ILPS22QS_1260hPa;
+
+  TEST_CHECK(ilps22qs_woc_start(&ctx, &md, 1.0f, 1.0f, &woc) == -1);
+
+  /* 1 hPa band, 0.2 hPa hysteresis: THS_P = 16, PHE / PLE / LIR, AUTOREFP */
+  press_set(&bus, 1000.0f);
+  TEST_CHECK(ilps22qs_woc_start(&ctx, &md, 1.0f, 0.2f, &woc) == 0);
+  TEST_CHECK(fabsf(woc.ref_hpa - 1000.0f) < 1e-3f);
+  TEST_CHECK((bus.regs[ILPS22QS_THS_P_L] == 16U) &&
+             (bus.regs[ILPS22QS_THS_P_H] == 0U));
+  TEST_CHECK((bus.regs[ILPS22QS_INTERRUPT_CFG] & 0x87U) == 0x87U);
+  ref_set(&bus, 1000.0f);
+
+  /* no latched event: a poll is one 1-byte read */
+  mock_bus_count_reset(&bus);
+  TEST_CHECK(ilps22qs_woc_event(&ctx, &md, &woc, &hpa, &changed) == 0);
+  TEST_CHECK((changed == 0U) && (woc.spurious == 0U));
+  TEST_CHECK((bus.rd == 1U) && (bus.rd_bytes == 1U) && (bus.wr == 0U));
+
+  /* 0.5 hPa excursion is within band - hysteresis */
+  press_set(&bus, 1000.5f);
+  bus.regs[ILPS22QS_INT_SOURCE] = 0x04U;
+  TEST_CHECK(ilps22qs_woc_event(&ctx, &md, &woc, &hpa, &changed) == 0);
+  TEST_CHECK((changed == 0U) && (woc.spurious == 1U));
+  TEST_CHECK(fabsf(woc.ref_hpa - 1000.0f) < 1e-3f);
+
+  /* 1.2 hPa is a change: reported and re-armed at the new level */
+  press_set(&bus, 1001.2f);
+  TEST_CHECK(ilps22qs_woc_event(&ctx, &md, &woc, &hpa, &changed) == 0);
+  TEST_CHECK((changed == 1U) && (woc.events == 1U));
+  TEST_CHECK(fabsf(hpa - 1001.2f) < 1e-3f);
+  TEST_CHECK(fabsf(woc.ref_hpa - 1001.2f) < 1e-3f);
+  TEST_CHECK((bus.regs[ILPS22QS_INTERRUPT_CFG] & 0x80U) != 0U);
+
+  /* the event is checked against the captured REF_P, not the old read */
+  ref_set(&bus, 1001.5f);
+  press_set(&bus, 1002.2f);
+  TEST_CHECK(ilps22qs_woc_event(&ctx, &md, &woc, &hpa, &changed) == 0);
+  TEST_CHECK((changed == 0U) && (woc.spurious == 2U));
+  TEST_CHECK(fabsf(woc.ref_hpa - 1001.5f) < 1e-3f);
+
+  TEST_CHECK(ilps22qs_woc_stop(&ctx) == 0);
+  TEST_CHECK((bus.regs[ILPS22QS_INTERRUPT_CFG] & 0x83U) == 0U);
+
+  return test_report("woc");
+}